@@ -4,22 +4,39 @@
 #include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <atomic>
+#include <optional>
 #include <src/function/SubmodularFunction.h>
 #include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/GroundSet.h>
+#include <src/function/cpu/HalfPrecisionExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/Int8ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/SharedMemoryGroundSet.h>
 #include <src/function/gpu/ExemplarClusteringSubmodularFunction.cuh>
+#include <src/io/FunctionArtifact.h>
+#include <src/io/MappedGroundSet.h>
+#include <src/optimizer/MixedPrecisionGreedy.h>
 
 namespace py = pybind11;
 using namespace exemcl;
 
-std::shared_ptr<SubmodularFunction> constructFunction(const MatrixX<double>& V, const std::string& precision, const std::string& dev, int workerCount) {
+template<typename Dissimilarity>
+std::shared_ptr<SubmodularFunction> constructFunction(const MatrixX<double>& V, const std::string& precision, const std::string& dev, int workerCount,
+                                                      const Dissimilarity& dissimilarity) {
+    constexpr bool squaredEuclidean = std::is_same<Dissimilarity, SquaredEuclidean>::value;
+
     if (precision == "fp16") {
         // -----------------
         // FP16 CONSTRUCTION
         // -----------------
         if (dev == "gpu")
-            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<__half, float>(V.cast<float>(), workerCount));
-        else if (dev == "cpu")
-            throw std::runtime_error("ExemCl: Construction failed. FP16 precision is not available on CPUs.");
+            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<__half, float, Dissimilarity>(V.cast<float>(), workerCount, dissimilarity));
+        else if (dev == "cpu") {
+            if constexpr (squaredEuclidean)
+                return std::shared_ptr<SubmodularFunction>(new cpu::HalfPrecisionExemplarClusteringSubmodularFunction<Eigen::half>(V.cast<float>(), workerCount));
+            else
+                throw std::runtime_error("ExemCl: Construction failed. FP16 precision on CPUs only supports the squared Euclidean distance.");
+        }
         else
             throw std::runtime_error("ExemCl: Construction failed. Unknown device '" + dev + "' provided. Choose either 'gpu' or 'cpu'.");
     } else if (precision == "fp32") {
@@ -27,9 +44,9 @@ std::shared_ptr<SubmodularFunction> constructFunction(const MatrixX<double>& V,
         // FP32 CONSTRUCTION
         // -----------------
         if (dev == "gpu")
-            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<float, float>(V.cast<float>(), workerCount));
+            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<float, float, Dissimilarity>(V.cast<float>(), workerCount, dissimilarity));
         else if (dev == "cpu")
-            return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<float>(V.cast<float>(), workerCount));
+            return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<float, Dissimilarity>(V.cast<float>(), workerCount, dissimilarity));
         else
             throw std::runtime_error("ExemCl: Construction failed. Unknown device '" + dev + "' provided. Choose either 'gpu' or 'cpu'.");
     } else if (precision == "fp64") {
@@ -37,26 +54,306 @@ std::shared_ptr<SubmodularFunction> constructFunction(const MatrixX<double>& V,
         // FP64 CONSTRUCTION
         // -----------------
         if (dev == "gpu")
-            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<double, double>(V, workerCount));
+            return std::shared_ptr<SubmodularFunction>(new gpu::ExemplarClusteringSubmodularFunction<double, double, Dissimilarity>(V, workerCount, dissimilarity));
         else if (dev == "cpu")
-            return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<double>(V, workerCount));
+            return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<double, Dissimilarity>(V, workerCount, dissimilarity));
+        else
+            throw std::runtime_error("ExemCl: Construction failed. Unknown device '" + dev + "' provided. Choose either 'gpu' or 'cpu'.");
+    } else if (precision == "bf16") {
+        // -----------------
+        // BF16 CONSTRUCTION
+        // -----------------
+        if (dev == "gpu")
+            throw std::runtime_error("ExemCl: Construction failed. BF16 precision is not available on GPUs.");
+        else if (dev == "cpu") {
+            if constexpr (squaredEuclidean)
+                return std::shared_ptr<SubmodularFunction>(new cpu::HalfPrecisionExemplarClusteringSubmodularFunction<Eigen::bfloat16>(V.cast<float>(), workerCount));
+            else
+                throw std::runtime_error("ExemCl: Construction failed. BF16 precision only supports the squared Euclidean distance.");
+        }
         else
             throw std::runtime_error("ExemCl: Construction failed. Unknown device '" + dev + "' provided. Choose either 'gpu' or 'cpu'.");
+    } else if (precision == "int8") {
+        // -----------------
+        // INT8 CONSTRUCTION
+        // -----------------
+        if (dev == "gpu")
+            throw std::runtime_error("ExemCl: Construction failed. INT8 precision is not available on GPUs.");
+        else if (dev == "cpu") {
+            if constexpr (squaredEuclidean)
+                return std::shared_ptr<SubmodularFunction>(new cpu::Int8ExemplarClusteringSubmodularFunction(V.cast<float>(), workerCount));
+            else
+                throw std::runtime_error("ExemCl: Construction failed. INT8 precision only supports the squared Euclidean distance.");
+        }
+        else
+            throw std::runtime_error("ExemCl: Construction failed. Unknown device '" + dev + "' provided. Choose either 'gpu' or 'cpu'.");
+    } else
+        throw std::runtime_error("ExemCl: Construction failed. Unknown precision '" + precision + "' provided. Choose either 'fp16', 'bf16', 'fp32', 'fp64' or 'int8'.");
+}
+
+std::shared_ptr<SubmodularFunction> constructFunction(const MatrixX<double>& V, const std::string& precision, const std::string& dev, int workerCount,
+                                                      const std::string& dissimilarity, const std::optional<VectorX<double>>& weights) {
+    if (dissimilarity != "mahalanobis" && weights)
+        throw std::runtime_error("ExemCl: Construction failed. Weights are only supported by the 'mahalanobis' dissimilarity.");
+
+    if (dissimilarity == "sqeuclidean")
+        return constructFunction(V, precision, dev, workerCount, SquaredEuclidean());
+    else if (dissimilarity == "l1")
+        return constructFunction(V, precision, dev, workerCount, Manhattan());
+    else if (dissimilarity == "cosine")
+        return constructFunction(V, precision, dev, workerCount, Cosine());
+    else if (dissimilarity == "mahalanobis") {
+        if (!weights)
+            throw std::runtime_error("ExemCl: Construction failed. The 'mahalanobis' dissimilarity requires weights.");
+        return constructFunction(V, precision, dev, workerCount, DiagonalMahalanobis(*weights));
+    } else
+        throw std::runtime_error("ExemCl: Construction failed. Unknown dissimilarity '" + dissimilarity
+                                 + "' provided. Choose either 'sqeuclidean', 'l1', 'cosine' or 'mahalanobis'.");
+}
+
+template<typename HostDataType, typename Dissimilarity>
+std::shared_ptr<SubmodularFunction> constructMappedFunction(const std::string& path, unsigned long dim, int workerCount, bool prefetch) {
+    bool npy = path.size() >= 4 && path.compare(path.size() - 4, 4, ".npy") == 0;
+    if (!npy && dim == 0)
+        throw std::runtime_error("ExemCl: Construction failed. Raw files require the dimensionality of the ground set.");
+    auto groundSet = npy ? MappedGroundSet<HostDataType>::fromNpy(path, prefetch) : MappedGroundSet<HostDataType>::fromRaw(path, dim, 0, prefetch);
+    return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity>(groundSet, workerCount));
+}
+
+std::shared_ptr<SubmodularFunction> constructMappedFunction(const std::string& path, const std::string& precision, int workerCount, unsigned long dim,
+                                                            const std::string& dissimilarity, bool prefetch) {
+    if (dissimilarity != "sqeuclidean" && dissimilarity != "l1")
+        throw std::runtime_error("ExemCl: Construction failed. Memory-mapped ground sets only support the 'sqeuclidean' and 'l1' dissimilarities.");
+    bool l1 = dissimilarity == "l1";
+
+    if (precision == "fp32")
+        return l1 ? constructMappedFunction<float, Manhattan>(path, dim, workerCount, prefetch)
+                  : constructMappedFunction<float, SquaredEuclidean>(path, dim, workerCount, prefetch);
+    else if (precision == "fp64")
+        return l1 ? constructMappedFunction<double, Manhattan>(path, dim, workerCount, prefetch)
+                  : constructMappedFunction<double, SquaredEuclidean>(path, dim, workerCount, prefetch);
+    else
+        throw std::runtime_error("ExemCl: Construction failed. Memory-mapped ground sets require 'fp32' or 'fp64' precision, which matches the type of the file.");
+}
+
+/**
+ * A ground set, which is shared by any number of CPU instances (see `cpu::GroundSet`). Python handles reference the same C++ object, hence V is held only once. Ground
+ * sets, which have been placed into shared memory (see `cpu::SharedMemoryGroundSet`), are pickled by name, hence child processes attach to them without any copy.
+ */
+struct SharedGroundSet {
+    std::string precision;
+    std::string dissimilarity;
+    std::shared_ptr<const cpu::GroundSet<float>> fp32;
+    std::shared_ptr<const cpu::GroundSet<double>> fp64;
+
+    // The name of the shared memory object (if any) and the publishing instance, which removes the name once the last owning handle is released.
+    std::string sharedMemoryName;
+    std::shared_ptr<const void> sharedMemoryOwner;
+
+    unsigned long rows() const {
+        return fp32 ? fp32->rows() : fp64->rows();
+    }
+
+    unsigned long cols() const {
+        return fp32 ? fp32->cols() : fp64->cols();
+    }
+
+    const VectorX<double>& dissimilarityParameters() const {
+        return fp32 ? fp32->getDissimilarityParameters() : fp64->getDissimilarityParameters();
+    }
+};
+
+template<typename Dissimilarity>
+std::shared_ptr<SharedGroundSet> constructGroundSet(const MatrixX<double>& V, const std::string& precision, int workerCount, const Dissimilarity& dissimilarity) {
+    auto groundSet = std::make_shared<SharedGroundSet>();
+    groundSet->precision = precision;
+    groundSet->dissimilarity = Dissimilarity::name;
+    if (precision == "fp32")
+        groundSet->fp32 = cpu::GroundSet<float>::create(V.cast<float>(), dissimilarity, workerCount);
+    else if (precision == "fp64")
+        groundSet->fp64 = cpu::GroundSet<double>::create(V, dissimilarity, workerCount);
+    else
+        throw std::runtime_error("ExemCl: Construction failed. Shared ground sets require 'fp32' or 'fp64' precision.");
+    return groundSet;
+}
+
+std::shared_ptr<SharedGroundSet> constructGroundSet(const MatrixX<double>& V, const std::string& precision, const std::string& dissimilarity, int workerCount,
+                                                    const std::optional<VectorX<double>>& weights) {
+    if (dissimilarity != "mahalanobis" && weights)
+        throw std::runtime_error("ExemCl: Construction failed. Weights are only supported by the 'mahalanobis' dissimilarity.");
+
+    std::shared_ptr<SharedGroundSet> groundSet;
+    if (dissimilarity == "sqeuclidean")
+        groundSet = constructGroundSet(V, precision, workerCount, SquaredEuclidean());
+    else if (dissimilarity == "l1")
+        groundSet = constructGroundSet(V, precision, workerCount, Manhattan());
+    else if (dissimilarity == "cosine")
+        groundSet = constructGroundSet(V, precision, workerCount, Cosine());
+    else if (dissimilarity == "mahalanobis") {
+        if (!weights)
+            throw std::runtime_error("ExemCl: Construction failed. The 'mahalanobis' dissimilarity requires weights.");
+        groundSet = constructGroundSet(V, precision, workerCount, DiagonalMahalanobis(*weights));
+    } else
+        throw std::runtime_error("ExemCl: Construction failed. Unknown dissimilarity '" + dissimilarity
+                                 + "' provided. Choose either 'sqeuclidean', 'l1', 'cosine' or 'mahalanobis'.");
+    return groundSet;
+}
+
+std::shared_ptr<SharedGroundSet> toSharedMemory(const SharedGroundSet& groundSet, const std::string& name) {
+    static std::atomic<unsigned long> counter(0);
+    auto shared = std::make_shared<SharedGroundSet>(groundSet);
+    shared->sharedMemoryName = name.empty() ? "/exemcl_" + std::to_string(getpid()) + "_" + std::to_string(counter++) : name;
+    if (groundSet.fp32) {
+        auto owner = std::make_shared<cpu::SharedMemoryGroundSet<float>>(*groundSet.fp32, shared->sharedMemoryName);
+        shared->fp32 = owner->getGroundSet();
+        shared->sharedMemoryOwner = owner;
+    } else {
+        auto owner = std::make_shared<cpu::SharedMemoryGroundSet<double>>(*groundSet.fp64, shared->sharedMemoryName);
+        shared->fp64 = owner->getGroundSet();
+        shared->sharedMemoryOwner = owner;
+    }
+    return shared;
+}
+
+std::shared_ptr<SharedGroundSet> attachSharedMemory(const std::string& name, const std::optional<VectorX<double>>& weights) {
+    auto groundSet = std::make_shared<SharedGroundSet>();
+    groundSet->sharedMemoryName = name;
+    unsigned int scalarSize = cpu::SharedMemoryGroundSet<float>::scalarSize(name);
+    if (scalarSize == sizeof(float)) {
+        groundSet->precision = "fp32";
+        groundSet->fp32 = cpu::SharedMemoryGroundSet<float>::attach(name);
+        groundSet->dissimilarity = groundSet->fp32->getDissimilarity();
+    } else if (scalarSize == sizeof(double)) {
+        groundSet->precision = "fp64";
+        groundSet->fp64 = cpu::SharedMemoryGroundSet<double>::attach(name);
+        groundSet->dissimilarity = groundSet->fp64->getDissimilarity();
     } else
-        throw std::runtime_error("ExemCl: Construction failed. Unknown precision '" + precision + "' provided. Choose either 'fp16', 'fp32' or 'fp64'.");
+        throw std::runtime_error("ExemCl: Attaching failed. The shared memory object holds scalars of unsupported size (" + std::to_string(scalarSize) + " byte).");
+
+    // The weights are published alongside the ground set, hence given weights are only cross-checked.
+    if (groundSet->dissimilarity != "mahalanobis" && weights)
+        throw std::runtime_error("ExemCl: Attaching failed. Weights are only supported by the 'mahalanobis' dissimilarity.");
+    if (weights && !equalDissimilarityParameters(*weights, groundSet->dissimilarityParameters()))
+        throw std::runtime_error("ExemCl: Attaching failed. The weights do not match the ones of the published ground set.");
+    return groundSet;
+}
+
+template<typename Dissimilarity>
+std::shared_ptr<SubmodularFunction> constructSharedFunction(const SharedGroundSet& groundSet, int workerCount, const Dissimilarity& dissimilarity) {
+    if (groundSet.fp32)
+        return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<float, Dissimilarity>(groundSet.fp32, workerCount, dissimilarity));
+    else
+        return std::shared_ptr<SubmodularFunction>(new cpu::ExemplarClusteringSubmodularFunction<double, Dissimilarity>(groundSet.fp64, workerCount, dissimilarity));
+}
+
+std::shared_ptr<SubmodularFunction> constructSharedFunction(const SharedGroundSet& groundSet, int workerCount) {
+    if (groundSet.dissimilarity == "sqeuclidean")
+        return constructSharedFunction(groundSet, workerCount, SquaredEuclidean());
+    else if (groundSet.dissimilarity == "l1")
+        return constructSharedFunction(groundSet, workerCount, Manhattan());
+    else if (groundSet.dissimilarity == "cosine")
+        return constructSharedFunction(groundSet, workerCount, Cosine());
+    else
+        return constructSharedFunction(groundSet, workerCount, DiagonalMahalanobis::fromParameters(groundSet.dissimilarityParameters()));
+}
+
+template<typename HostDataType, typename Dissimilarity>
+bool saveFunction(const SubmodularFunction& function, const std::string& path) {
+    auto* cpuFunction = dynamic_cast<const cpu::ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity>*>(&function);
+    if (cpuFunction != nullptr)
+        cpuFunction->save(path);
+    return cpuFunction != nullptr;
+}
+
+void saveFunction(const SubmodularFunction& function, const std::string& path) {
+    if (!saveFunction<float, SquaredEuclidean>(function, path) && !saveFunction<float, Manhattan>(function, path) && !saveFunction<float, Cosine>(function, path)
+        && !saveFunction<float, DiagonalMahalanobis>(function, path) && !saveFunction<double, SquaredEuclidean>(function, path)
+        && !saveFunction<double, Manhattan>(function, path) && !saveFunction<double, Cosine>(function, path) && !saveFunction<double, DiagonalMahalanobis>(function, path))
+        throw std::runtime_error("ExemCl: Saving failed. Only CPU instances with 'fp32' or 'fp64' precision can be saved.");
+}
+
+template<typename Dissimilarity>
+std::shared_ptr<SubmodularFunction> loadFunction(const std::string& path, unsigned int scalarSize, int workerCount, const std::optional<Dissimilarity>& dissimilarity) {
+    if (scalarSize == sizeof(float))
+        return cpu::ExemplarClusteringSubmodularFunction<float, Dissimilarity>::load(path, workerCount, dissimilarity);
+    else if (scalarSize == sizeof(double))
+        return cpu::ExemplarClusteringSubmodularFunction<double, Dissimilarity>::load(path, workerCount, dissimilarity);
+    else
+        throw std::runtime_error("ExemCl: Loading failed. The artifact holds scalars of unsupported size (" + std::to_string(scalarSize) + " byte).");
+}
+
+std::shared_ptr<SubmodularFunction> loadFunction(const std::string& path, int workerCount, const std::optional<VectorX<double>>& weights) {
+    // The precision, the dissimilarity and its parameters are taken from the artifact. Weights are only cross-checked.
+    FunctionArtifactHeader header = readFunctionArtifactHeader(path);
+    const std::string dissimilarity = header.dissimilarity;
+    if (dissimilarity != "mahalanobis" && weights)
+        throw std::runtime_error("ExemCl: Loading failed. Weights are only supported by the 'mahalanobis' dissimilarity.");
+
+    if (dissimilarity == "sqeuclidean")
+        return loadFunction(path, header.scalarSize, workerCount, std::optional<SquaredEuclidean>());
+    else if (dissimilarity == "l1")
+        return loadFunction(path, header.scalarSize, workerCount, std::optional<Manhattan>());
+    else if (dissimilarity == "cosine")
+        return loadFunction(path, header.scalarSize, workerCount, std::optional<Cosine>());
+    else if (dissimilarity == "mahalanobis")
+        return loadFunction(path, header.scalarSize, workerCount, weights ? std::optional<DiagonalMahalanobis>(*weights) : std::nullopt);
+    else
+        throw std::runtime_error("ExemCl: Loading failed. Unknown dissimilarity '" + dissimilarity + "' in '" + path + "'.");
 }
 
 PYBIND11_MODULE(exemcl, m) {
     m.doc() = "exemcl python plugin";
 
+    py::class_<SharedGroundSet, std::shared_ptr<SharedGroundSet>>(m, "GroundSet")
+        .def(py::init(py::overload_cast<const MatrixX<double>&, const std::string&, const std::string&, int, const std::optional<VectorX<double>>&>(&constructGroundSet)),
+             py::arg("ground_set"), py::arg("precision") = "fp32", py::arg("dissimilarity") = "sqeuclidean", py::arg("worker_count") = -1,
+             py::arg("weights") = py::none())
+        .def_readonly("precision", &SharedGroundSet::precision)
+        .def_readonly("dissimilarity", &SharedGroundSet::dissimilarity)
+        .def_readonly("shared_memory_name", &SharedGroundSet::sharedMemoryName)
+        .def_property_readonly("rows", &SharedGroundSet::rows)
+        .def_property_readonly("cols", &SharedGroundSet::cols)
+        .def("to_shared_memory", &toSharedMemory, py::arg("name") = "")
+        .def_static("attach", &attachSharedMemory, py::arg("name"), py::arg("weights") = py::none())
+        .def(py::pickle(
+            [](const SharedGroundSet& groundSet) {
+                if (groundSet.sharedMemoryName.empty())
+                    throw std::runtime_error("ExemCl: Pickling failed. Only ground sets in shared memory can be pickled (see GroundSet.to_shared_memory).");
+                return py::make_tuple(groundSet.sharedMemoryName);
+            },
+            [](const py::tuple& state) { return attachSharedMemory(state[0].cast<std::string>(), std::nullopt); }));
+
     py::class_<SubmodularFunction, std::shared_ptr<SubmodularFunction>>(m, "ExemplarClustering")
-        .def(py::init<>(&constructFunction), py::arg("ground_set"), py::arg("precision") = "fp32", py::arg("device") = "gpu", py::arg("worker_count") = -1)
+        .def(py::init(py::overload_cast<const MatrixX<double>&, const std::string&, const std::string&, int, const std::string&, const std::optional<VectorX<double>>&>(
+                 &constructFunction)),
+             py::arg("ground_set"), py::arg("precision") = "fp32", py::arg("device") = "gpu", py::arg("worker_count") = -1, py::arg("dissimilarity") = "sqeuclidean",
+             py::arg("weights") = py::none())
+        .def_static("from_file", py::overload_cast<const std::string&, const std::string&, int, unsigned long, const std::string&, bool>(&constructMappedFunction),
+                    py::arg("path"), py::arg("precision") = "fp32", py::arg("worker_count") = -1, py::arg("dim") = 0, py::arg("dissimilarity") = "sqeuclidean",
+                    py::arg("prefetch") = false)
         .def("__call__", py::overload_cast<const MatrixX<double>&>(&SubmodularFunction::operator()), py::arg("S"))
         .def("__call__", py::overload_cast<const MatrixX<double>&, const VectorXRef<double>>(&SubmodularFunction::operator()), py::arg("S"), py::arg("e"))
         .def("__call__", py::overload_cast<const MatrixX<double>&, const std::vector<VectorXRef<double>>>(&SubmodularFunction::operator()), py::arg("S"), py::arg("e_multi"))
         .def("__call__", py::overload_cast<const std::vector<MatrixX<double>>&, const VectorXRef<double>>(&SubmodularFunction::operator()), py::arg("S_multi"), py::arg("e"))
         .def("__call__", py::overload_cast<const std::vector<MatrixX<double>>&>(&SubmodularFunction::operator()), py::arg("S_multi"))
+        .def_static("from_ground_set", py::overload_cast<const SharedGroundSet&, int>(&constructSharedFunction), py::arg("ground_set"), py::arg("worker_count") = -1)
+        .def_static("load", &loadFunction, py::arg("path"), py::arg("worker_count") = -1, py::arg("weights") = py::none())
+        .def("save", py::overload_cast<const SubmodularFunction&, const std::string&>(&saveFunction), py::arg("path"))
         .def("set_memory_limit", &SubmodularFunction::setMemoryLimit, py::arg("memory_limit"));
+
+    py::class_<GreedyResult>(m, "GreedyResult")
+        .def_readonly("indices", &GreedyResult::indices)
+        .def_readonly("S", &GreedyResult::S)
+        .def_readonly("gains", &GreedyResult::gains)
+        .def_readonly("value", &GreedyResult::value)
+        .def_readonly("reranked", &GreedyResult::reranked);
+
+    m.def(
+        "mixed_precision_greedy",
+        [](const SubmodularFunction& fast, const SubmodularFunction& exact, const MatrixX<double>& candidates, unsigned int k, double absoluteMargin, double relativeMargin) {
+            return MixedPrecisionGreedy(fast, exact, absoluteMargin, relativeMargin).optimize(candidates, k);
+        },
+        py::arg("fast"), py::arg("exact"), py::arg("candidates"), py::arg("k"), py::arg("absolute_margin") = 0.0, py::arg("relative_margin") = 0.01);
 }
 
 #endif // EXEMCL_PYTHONBINDING_H
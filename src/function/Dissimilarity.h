@@ -0,0 +1,209 @@
+#ifndef EXEMCL_DISSIMILARITY_H
+#define EXEMCL_DISSIMILARITY_H
+
+#include <cmath>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+
+#ifdef __CUDACC__
+    #include <cuda_fp16.h>
+    #define EXEMCL_HOST_DEVICE __host__ __device__
+#else
+    #define EXEMCL_HOST_DEVICE
+#endif
+
+namespace exemcl {
+    /**
+     * Computes the absolute value of `x` on both host and device.
+     */
+    template<typename T>
+    EXEMCL_HOST_DEVICE inline T absolute(T x) {
+        return x < static_cast<T>(0) ? -x : x;
+    }
+
+#ifdef __CUDACC__
+    __device__ inline __half absolute(__half x) {
+        return __habs(x);
+    }
+
+    __device__ inline __half2 absolute(__half2 x) {
+        return __habs2(x);
+    }
+#endif
+
+    /**
+     * Dissimilarity policies define the dissimilarity \f$d(v, s)\f$, which is minimized over the exemplars. Every policy provides
+     *
+     * - `name`, which identifies the policy (e.g. within saved artifacts),
+     * - `parameters()` alongside `fromParameters(parameters)`, which export and restore the parameters of the policy (e.g. the weights of `DiagonalMahalanobis`), such
+     *   that prepared ground sets and artifacts can be matched against a policy instance,
+     * - `prepare(X)`, which transforms the ground set and every evaluated set exactly once (e.g. normalization or scaling),
+     * - `evaluate(v, s)`, which computes \f$d(v, s)\f$ for two prepared (Eigen) row vectors on the CPU and
+     * - `accumulate(accu, v_d, s_d)` alongside `finalize(accu)`, which compute \f$d(v, s)\f$ element by element within the CUDA kernels.
+     *
+     * Policies are passed as template parameters, such that the choice of a dissimilarity does not add any cost per evaluation. The auxiliary zero vector of the exemplar
+     * clustering function is never transformed.
+     */
+    struct SquaredEuclidean {
+        static constexpr const char* name = "sqeuclidean";
+
+        VectorX<double> parameters() const {
+            return VectorX<double>();
+        }
+
+        static SquaredEuclidean fromParameters(const VectorX<double>&) {
+            return SquaredEuclidean();
+        }
+
+        template<typename Derived>
+        void prepare(Eigen::MatrixBase<Derived>&) const { }
+
+        template<typename VType, typename SType>
+        static typename VType::Scalar evaluate(const Eigen::MatrixBase<VType>& v, const Eigen::MatrixBase<SType>& s) {
+            return (v - s).squaredNorm();
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T accumulate(T accu, T v, T s) {
+            T diff = v - s;
+            return accu + diff * diff;
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T finalize(T accu) {
+            return accu;
+        }
+    };
+
+    /**
+     * The Manhattan (L1) distance \f$d(v, s) = \|v - s\|_1\f$.
+     */
+    struct Manhattan {
+        static constexpr const char* name = "l1";
+
+        VectorX<double> parameters() const {
+            return VectorX<double>();
+        }
+
+        static Manhattan fromParameters(const VectorX<double>&) {
+            return Manhattan();
+        }
+
+        template<typename Derived>
+        void prepare(Eigen::MatrixBase<Derived>&) const { }
+
+        template<typename VType, typename SType>
+        static typename VType::Scalar evaluate(const Eigen::MatrixBase<VType>& v, const Eigen::MatrixBase<SType>& s) {
+            return (v - s).cwiseAbs().sum();
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T accumulate(T accu, T v, T s) {
+            return accu + absolute(v - s);
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T finalize(T accu) {
+            return accu;
+        }
+    };
+
+    /**
+     * The cosine dissimilarity \f$d(v, s) = 1 - \frac{\langle v, s \rangle}{\|v\| \|s\|}\f$. All vectors are normalized once by `prepare`, hence the evaluation reduces to
+     * a dot product. The dissimilarity to the zero vector equals one.
+     */
+    struct Cosine {
+        static constexpr const char* name = "cosine";
+
+        VectorX<double> parameters() const {
+            return VectorX<double>();
+        }
+
+        static Cosine fromParameters(const VectorX<double>&) {
+            return Cosine();
+        }
+
+        template<typename Derived>
+        void prepare(Eigen::MatrixBase<Derived>& X) const {
+            for (Eigen::Index i = 0; i < X.rows(); i++) {
+                auto norm = X.row(i).norm();
+                if (norm > 0)
+                    X.row(i) /= norm;
+            }
+        }
+
+        template<typename VType, typename SType>
+        static typename VType::Scalar evaluate(const Eigen::MatrixBase<VType>& v, const Eigen::MatrixBase<SType>& s) {
+            return static_cast<typename VType::Scalar>(1) - v.dot(s);
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T accumulate(T accu, T v, T s) {
+            return accu + v * s;
+        }
+
+        template<typename T>
+        EXEMCL_HOST_DEVICE static T finalize(T accu) {
+            return static_cast<T>(1.0f) - accu;
+        }
+    };
+
+    /**
+     * The Mahalanobis distance with a diagonal covariance matrix, i.e. \f$d(v, s) = \sum_d w_d (v_d - s_d)^2\f$. All vectors are scaled by \f$\sqrt{w_d}\f$ once by
+     * `prepare`, hence the evaluation reduces to the squared Euclidean distance.
+     */
+    struct DiagonalMahalanobis : public SquaredEuclidean {
+        static constexpr const char* name = "mahalanobis";
+
+        DiagonalMahalanobis() = default;
+
+        /**
+         * Constructs the policy.
+         * @param weights The non-negative weights \f$w_d\f$ (usually the inverse variances) for every dimension.
+         */
+        explicit DiagonalMahalanobis(const VectorX<double>& weights) : _weights(weights) {
+            if ((weights.array() < 0.0).any())
+                throw std::runtime_error("DiagonalMahalanobis::DiagonalMahalanobis: The weights must not be negative.");
+            _scales = weights.cwiseSqrt();
+        }
+
+        /**
+         * Returns the weights \f$w_d\f$.
+         * @return As stated above.
+         */
+        VectorX<double> parameters() const {
+            return _weights;
+        }
+
+        static DiagonalMahalanobis fromParameters(const VectorX<double>& parameters) {
+            return DiagonalMahalanobis(parameters);
+        }
+
+        template<typename Derived>
+        void prepare(Eigen::MatrixBase<Derived>& X) const {
+            if (X.cols() != _scales.size())
+                throw std::runtime_error("DiagonalMahalanobis::prepare: The number of weights does not match the dimensionality (" + std::to_string(_scales.size()) + " vs. "
+                                         + std::to_string(X.cols()) + ").");
+            for (Eigen::Index d = 0; d < X.cols(); d++)
+                X.col(d) *= static_cast<typename Derived::Scalar>(_scales[d]);
+        }
+
+    private:
+        VectorX<double> _weights;
+        VectorX<double> _scales;
+    };
+
+    /**
+     * Returns true, if two parameter vectors of a dissimilarity policy (see `SquaredEuclidean::parameters`) are identical.
+     *
+     * @param lhs The first parameter vector.
+     * @param rhs The second parameter vector.
+     * @return As stated above.
+     */
+    inline bool equalDissimilarityParameters(const VectorX<double>& lhs, const VectorX<double>& rhs) {
+        return lhs.size() == rhs.size() && (lhs.array() == rhs.array()).all();
+    }
+}
+
+#endif // EXEMCL_DISSIMILARITY_H
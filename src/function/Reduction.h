@@ -0,0 +1,132 @@
+#ifndef EXEMCL_REDUCTION_H
+#define EXEMCL_REDUCTION_H
+
+#include <algorithm>
+#include <vector>
+
+namespace exemcl {
+    /**
+     * Describes how the per-point minimal distances are summed up to obtain \f$L(S)\f$.
+     */
+    enum class ReductionMode {
+        Naive,      // Sequential (vectorized) summation in the working precision. The error grows linearly with |V|.
+        Compensated // Blocked pairwise summation with Kahan-compensated blocks (CPU) or fp64 accumulators (GPU). The error is independent of |V| for all practical sizes.
+    };
+
+    /**
+     * Number of values, which are summed up with Kahan compensation before the pairwise tree is entered.
+     */
+    constexpr unsigned long ReductionBlockSize = 256;
+
+    /**
+     * Sums up `n` values with Kahan compensation. The running sum is kept in the precision of `T`, the remaining compensation is applied in double precision, such that the
+     * result is not rounded to `T`.
+     *
+     * @param values The values to sum up.
+     * @param n The number of values.
+     * @return The sum.
+     */
+    template<typename T>
+    double kahanSum(const T* values, unsigned long n) {
+        T sum = 0;
+        T compensation = 0;
+        for (unsigned long i = 0; i < n; i++) {
+            T y = values[i] - compensation;
+            T t = sum + y;
+            compensation = (t - sum) - y;
+            sum = t;
+        }
+        return static_cast<double>(sum) - static_cast<double>(compensation);
+    }
+
+    /**
+     * Sums up `n` values by recursively halving the range until it fits into a single block, which is then summed up with Kahan compensation. Partial sums are combined
+     * in double precision, hence the error of the result is bounded by \f$O(\epsilon_{\text{fp64}} \log(n / \text{ReductionBlockSize}))\f$ regardless of `T`.
+     *
+     * @param values The values to sum up.
+     * @param n The number of values.
+     * @return The sum.
+     */
+    template<typename T>
+    double pairwiseSum(const T* values, unsigned long n) {
+        if (n <= ReductionBlockSize)
+            return kahanSum(values, n);
+
+        // Split at a multiple of the block size, such that the block boundaries only depend on `n`.
+        unsigned long blocks = (n + ReductionBlockSize - 1) / ReductionBlockSize;
+        unsigned long mid = (blocks / 2) * ReductionBlockSize;
+        return pairwiseSum(values, mid) + pairwiseSum(values + mid, n - mid);
+    }
+
+    /**
+     * Sums up a single block (of at most `ReductionBlockSize` values) of the compensated or the deterministic reduction (see `reduceSum`).
+     *
+     * @param block The values to sum up.
+     * @param len The number of values.
+     * @param mode The reduction mode.
+     * @return The sum.
+     */
+    template<typename T>
+    double blockSum(const T* block, unsigned long len, ReductionMode mode) {
+        if (mode == ReductionMode::Compensated)
+            return kahanSum(block, len);
+        T accu = 0.0;
+#pragma omp simd reduction(+ : accu)
+        for (unsigned long i = 0; i < len; i++)
+            accu += block[i];
+        return static_cast<double>(accu);
+    }
+
+    /**
+     * Sums up `n` values according to a reduction mode, using up to `workerCount` threads.
+     *
+     * In compensated or deterministic mode, the values are split into blocks of `ReductionBlockSize` values. Every block is summed up independently and the block sums are
+     * combined in a fixed pairwise tree. Since neither the block boundaries nor the tree depend on the number of threads, the result is bit-identical for every
+     * `workerCount`. Otherwise, the values are summed up by an OpenMP reduction, whose order depends on the number of threads.
+     *
+     * @param values The values to sum up.
+     * @param n The number of values.
+     * @param mode The reduction mode.
+     * @param workerCount The number of threads to employ.
+     * @param deterministic Enforces a thread-count independent summation order in naive mode (compensated mode is always deterministic).
+     * @param blockSums Scratch buffer for the block sums, which is only reallocated, if its capacity does not suffice. Hence, repeated reductions do not allocate.
+     * @return The sum.
+     */
+    template<typename T>
+    double reduceSum(const T* values, unsigned long n, ReductionMode mode, unsigned int workerCount, bool deterministic, std::vector<double>& blockSums) {
+        if (mode == ReductionMode::Compensated || deterministic) {
+            const unsigned long blockCount = (n + ReductionBlockSize - 1) / ReductionBlockSize;
+            blockSums.resize(blockCount);
+
+#pragma omp parallel for num_threads(workerCount) schedule(static)
+            for (unsigned long b = 0; b < blockCount; b++)
+                blockSums[b] = blockSum(values + b * ReductionBlockSize, std::min(ReductionBlockSize, n - b * ReductionBlockSize), mode);
+
+            return pairwiseSum(blockSums.data(), blockCount);
+        }
+
+        T accu = 0.0;
+#pragma omp parallel for simd num_threads(workerCount) reduction(+ : accu)
+        for (unsigned long i = 0; i < n; i++)
+            accu += values[i];
+        return static_cast<double>(accu);
+    }
+
+    /**
+     * Sums up `n` values according to a reduction mode (see above), using a temporary buffer for the block sums.
+     *
+     * @param values The values to sum up.
+     * @param n The number of values.
+     * @param mode The reduction mode.
+     * @param workerCount The number of threads to employ.
+     * @param deterministic Enforces a thread-count independent summation order in naive mode (compensated mode is always deterministic).
+     * @return The sum.
+     */
+    template<typename T>
+    double reduceSum(const T* values, unsigned long n, ReductionMode mode, unsigned int workerCount = 1, bool deterministic = false) {
+        std::vector<double> blockSums;
+        return reduceSum(values, n, mode, workerCount, deterministic, blockSums);
+    }
+}
+
+#endif // EXEMCL_REDUCTION_H
@@ -1,11 +1,25 @@
 #ifndef EXEMCL_SUBM_FUNCTION_H
 #define EXEMCL_SUBM_FUNCTION_H
 
+#include <src/function/Reduction.h>
 #include <src/io/DataTypes.h>
 #include <thread>
 #include <utility>
 
 namespace exemcl {
+    /**
+     * Resolves a requested worker count. Values below one select the number of cores available to the program (or a single worker, if that number is unknown).
+     *
+     * @param workerCount The requested number of workers.
+     * @return The number of workers to employ.
+     */
+    inline unsigned int resolveWorkerCount(int workerCount) {
+        if (workerCount >= 1)
+            return workerCount;
+        auto suggestedThreads = std::thread::hardware_concurrency();
+        return suggestedThreads > 0 ? suggestedThreads : 1;
+    }
+
     /**
      * Submodular functions represent a special kind of set function, which map subsets (usually denoted as \f$S\f$) of some ground set
      * (denoted by \f$V\f$) to a positive real value (sometimes called the "utility"), whilst maintaining a property of diminishing returns.
@@ -210,14 +224,45 @@ namespace exemcl {
          * @param workerCount New worker count.
          */
         virtual void setWorkerCount(int workerCount) {
-            if (workerCount >= 1)
-                _workerCount = workerCount;
-            else {
-                auto suggestedThreads = std::thread::hardware_concurrency();
-                _workerCount = suggestedThreads > 0 ? suggestedThreads : 1;
-            }
+            _workerCount = resolveWorkerCount(workerCount);
         }
 
+        /**
+         * Returns the reduction mode, which is used to sum up per-point contributions.
+         * @return Reduction mode.
+         */
+        virtual ReductionMode getReductionMode() const {
+            return _reductionMode;
+        };
+
+        /**
+         * Updates the reduction mode, which is used to sum up per-point contributions. Implementations, which always accumulate in double precision, are not affected.
+         *
+         * @param reductionMode New reduction mode.
+         */
+        virtual void setReductionMode(ReductionMode reductionMode) {
+            _reductionMode = reductionMode;
+        };
+
+        /**
+         * Returns, whether the function is evaluated deterministically, i.e. whether the result is independent of the worker count.
+         * @return As stated above.
+         */
+        virtual bool isDeterministic() const {
+            return _deterministic;
+        };
+
+        /**
+         * Enables or disables deterministic evaluation. In deterministic mode, per-point contributions are summed up in fixed-size blocks, which are combined in a fixed tree
+         * order, such that results are bit-identical for every worker count. Batch evaluations evaluate every set independently and are hence deterministic as well. Please
+         * note, that the compensated reduction mode is always deterministic.
+         *
+         * @param deterministic True, if results need to be independent of the worker count.
+         */
+        virtual void setDeterministic(bool deterministic) {
+            _deterministic = deterministic;
+        };
+
         /**
          * Limits the usable memory by this class. Must be overridden by the implementing class and yields an exception otherwise.
          * @param memoryLimit Memory limit (in byte).
@@ -233,6 +278,8 @@ namespace exemcl {
 
     protected:
         unsigned int _workerCount = 1;
+        ReductionMode _reductionMode = ReductionMode::Compensated;
+        bool _deterministic = false;
     };
 }
 
@@ -0,0 +1,160 @@
+#ifndef EXEMCL_FUNCTION_CPU_ALLOCATIONPOLICY
+#define EXEMCL_FUNCTION_CPU_ALLOCATIONPOLICY
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+
+namespace exemcl::cpu {
+    /**
+     * Allocates with Eigen's default allocator (i.e. 16-byte aligned `malloc`). A ground set, which is created with this policy, adopts V without any copy.
+     *
+     * Every allocation policy provides `allocate(bytes)` and `deallocate(pointer, bytes)`, which receives the size of the allocation, as well as a `name`.
+     */
+    struct DefaultAllocation {
+        static constexpr const char* name = "default";
+
+        static void* allocate(std::size_t bytes) {
+            return Eigen::internal::aligned_malloc(bytes);
+        };
+
+        static void deallocate(void* pointer, std::size_t) {
+            Eigen::internal::aligned_free(pointer);
+        };
+    };
+
+    /**
+     * Allocates at cache-line boundaries (64 bytes), such that rows of V never straddle more cache lines than necessary and per-thread scratch buffers do not share a line
+     * at their beginning.
+     */
+    struct AlignedAllocation {
+        static constexpr const char* name = "aligned";
+        static constexpr std::size_t Alignment = 64;
+
+        static void* allocate(std::size_t bytes) {
+            void* pointer = std::aligned_alloc(Alignment, (bytes + Alignment - 1) / Alignment * Alignment);
+            if (pointer == nullptr && bytes > 0)
+                throw std::runtime_error("AlignedAllocation::allocate: Unable to allocate " + std::to_string(bytes) + " byte.");
+            return pointer;
+        };
+
+        static void deallocate(void* pointer, std::size_t) {
+            std::free(pointer);
+        };
+    };
+
+    /**
+     * Backs large allocations (at least one huge page) by transparent huge pages, i.e. the memory is aligned to and padded to a multiple of 2 MiB and the kernel is advised
+     * to back it by huge pages (see `madvise(MADV_HUGEPAGE)`). Hence, a scan over V takes one TLB entry per 2 MiB rather than per 4 KiB. Smaller allocations fall back to
+     * `AlignedAllocation`. If transparent huge pages are disabled on the host, the memory is backed by regular pages.
+     */
+    struct TransparentHugePageAllocation {
+        static constexpr const char* name = "thp";
+        static constexpr std::size_t HugePageSize = 2ul << 20;
+
+        static void* allocate(std::size_t bytes) {
+            if (bytes < HugePageSize)
+                return AlignedAllocation::allocate(bytes);
+            return map(padded(bytes));
+        };
+
+        static void deallocate(void* pointer, std::size_t bytes) {
+            if (bytes < HugePageSize)
+                AlignedAllocation::deallocate(pointer, bytes);
+            else if (pointer != nullptr)
+                munmap(pointer, padded(bytes));
+        };
+
+        /**
+         * Returns the length of a mapping, which holds `bytes` bytes (a multiple of `pageSize`).
+         */
+        static std::size_t padded(std::size_t bytes, std::size_t pageSize = HugePageSize) {
+            return (bytes + pageSize - 1) / pageSize * pageSize;
+        };
+
+        /**
+         * Maps `length` bytes (a multiple of the huge page size) at a huge page boundary and advises the kernel to back them by huge pages.
+         */
+        static void* map(std::size_t length) {
+            // Over-allocate by a huge page and trim the unaligned head and tail.
+            void* base = mmap(nullptr, length + HugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+                throw std::runtime_error("TransparentHugePageAllocation::map: Unable to map " + std::to_string(length) + " byte (" + std::strerror(errno) + ").");
+            char* begin = static_cast<char*>(base);
+            char* aligned = begin + (HugePageSize - reinterpret_cast<std::uintptr_t>(begin) % HugePageSize) % HugePageSize;
+            if (aligned > begin)
+                munmap(begin, aligned - begin);
+            if (aligned + length < begin + length + HugePageSize)
+                munmap(aligned + length, begin + length + HugePageSize - (aligned + length));
+            madvise(aligned, length, MADV_HUGEPAGE);
+            return aligned;
+        };
+    };
+
+    /**
+     * Backs large allocations (at least one page of the pool) by explicit huge pages from the pool of the kernel (see `MAP_HUGETLB` and `/proc/sys/vm/nr_hugepages`),
+     * which are neither split nor swapped. Allocations are padded to the default huge page size of the host (see `pageSize`), which may exceed 2 MiB (e.g. 1 GiB).
+     * Smaller allocations fall back to `TransparentHugePageAllocation`, and so do allocations, for which the pool is exhausted (with the same padding).
+     */
+    struct ExplicitHugePageAllocation {
+        static constexpr const char* name = "hugetlb";
+
+        static void* allocate(std::size_t bytes) {
+            if (bytes < pageSize())
+                return TransparentHugePageAllocation::allocate(bytes);
+            const std::size_t length = TransparentHugePageAllocation::padded(bytes, pageSize());
+            void* pointer = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            return pointer != MAP_FAILED ? pointer : TransparentHugePageAllocation::map(length);
+        };
+
+        static void deallocate(void* pointer, std::size_t bytes) {
+            // Both kinds of mappings span the same length, hence they are released alike.
+            if (bytes < pageSize())
+                TransparentHugePageAllocation::deallocate(pointer, bytes);
+            else if (pointer != nullptr)
+                munmap(pointer, TransparentHugePageAllocation::padded(bytes, pageSize()));
+        };
+
+        /**
+         * Returns the size of the pages of the pool, i.e. the default huge page size of the host (see `Hugepagesize` in `/proc/meminfo`), or 2 MiB, if it is unknown.
+         * @return As stated above.
+         */
+        static std::size_t pageSize() {
+            static const std::size_t size = []() {
+                std::ifstream meminfo("/proc/meminfo");
+                std::string key;
+                std::size_t kibibytes = 0;
+                while (meminfo >> key) {
+                    if (key == "Hugepagesize:" && meminfo >> kibibytes && kibibytes > 0)
+                        return std::max<std::size_t>(kibibytes << 10, TransparentHugePageAllocation::HugePageSize);
+                    meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                }
+                return TransparentHugePageAllocation::HugePageSize;
+            }();
+            return size;
+        };
+    };
+
+    /**
+     * Allocates an array of `n` (uninitialized) scalars by an allocation policy, which is released, once the last reference is dropped.
+     *
+     * @param n The number of scalars.
+     * @return As stated above.
+     */
+    template<typename T, typename Allocation>
+    std::shared_ptr<T> allocateShared(std::size_t n) {
+        const std::size_t bytes = n * sizeof(T);
+        return std::shared_ptr<T>(static_cast<T*>(Allocation::allocate(bytes)), [bytes](T* pointer) { Allocation::deallocate(pointer, bytes); });
+    }
+}
+
+#endif // EXEMCL_FUNCTION_CPU_ALLOCATIONPOLICY
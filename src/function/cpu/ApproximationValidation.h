@@ -0,0 +1,59 @@
+#ifndef EXEMCL_FUNCTION_CPU_APPROXIMATIONVALIDATION
+#define EXEMCL_FUNCTION_CPU_APPROXIMATIONVALIDATION
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+
+namespace exemcl::cpu {
+    /**
+     * Summarizes the observed error of an approximate function w.r.t. the exact function.
+     */
+    struct ApproximationError {
+        double maxRelativeError = 0.0;   // Maximum relative error of f(S) on the validation sets.
+        double meanRelativeError = 0.0;  // Mean relative error of f(S) on the validation sets.
+        unsigned int validationSets = 0; // The number of validation sets.
+    };
+
+    /**
+     * Compares an approximate function against the exact function over V on random subsets of V. The sets grow from one to \f$1 + 4 (n - 1)\f$ points, such that both the
+     * early and the late phase of an optimization are covered. Please note, that the exact function evaluates the whole ground set.
+     *
+     * @param V The ground set V.
+     * @param approximation The approximate function, i.e. a callable, which maps a set S to \f$f(S)\f$.
+     * @param validationSets The number of random subsets \f$n\f$.
+     * @param generator The random number generator, which samples the subsets.
+     * @param workerCount The number of workers to employ for the exact function.
+     * @return The observed errors.
+     */
+    template<typename HostDataType, typename Approximation>
+    ApproximationError validateApproximation(const MatrixX<HostDataType>& V, Approximation&& approximation, unsigned int validationSets, std::mt19937_64& generator,
+                                             int workerCount) {
+        ApproximationError error;
+        if (validationSets == 0)
+            return error;
+
+        ExemplarClusteringSubmodularFunction<HostDataType> exactFunction(V, workerCount);
+        std::uniform_int_distribution<Eigen::Index> rowDistribution(0, V.rows() - 1);
+
+        double errorSum = 0.0;
+        for (unsigned int k = 0; k < validationSets; k++) {
+            MatrixX<double> S(std::min<Eigen::Index>(1 + k * 4, V.rows()), V.cols());
+            for (Eigen::Index i = 0; i < S.rows(); i++)
+                S.row(i) = V.row(rowDistribution(generator)).template cast<double>();
+
+            double exactValue = exactFunction(S);
+            double relativeError = std::abs(approximation(S) - exactValue) / std::max(std::abs(exactValue), std::numeric_limits<double>::epsilon());
+            error.maxRelativeError = std::max(error.maxRelativeError, relativeError);
+            errorSum += relativeError;
+        }
+        error.meanRelativeError = errorSum / validationSets;
+        error.validationSets = validationSets;
+
+        return error;
+    }
+}
+
+#endif // EXEMCL_FUNCTION_CPU_APPROXIMATIONVALIDATION
@@ -0,0 +1,171 @@
+#ifndef EXEMCL_BALLTREE_H
+#define EXEMCL_BALLTREE_H
+
+#include <algorithm>
+#include <numeric>
+#include <src/io/DataTypes.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * A ball tree is a hierarchical spatial index over a ground set \f$V\f$. Every node covers a contiguous range of (internally reordered) points and stores the center and
+     * radius of a ball, which encloses all points of the node. This allows to bound the distance between an arbitrary vector \f$e\f$ and all points of a node, i.e.
+     * \f$\|v - e\| \geq \max(0, \|c - e\| - r)\f$ for every \f$v\f$ in a node with center \f$c\f$ and radius \f$r\f$.
+     */
+    template<typename HostDataType = float>
+    class BallTree {
+    public:
+        /**
+         * A single node of the ball tree.
+         */
+        struct Node {
+            unsigned long begin;   // Index of the first point (inclusive) within the reordered point matrix.
+            unsigned long end;     // Index of the last point (exclusive) within the reordered point matrix.
+            long left = -1;        // Index of the left child node (-1, if the node is a leaf).
+            long right = -1;       // Index of the right child node (-1, if the node is a leaf).
+            HostDataType radius;   // Radius of the enclosing ball.
+
+            bool isLeaf() const {
+                return left < 0;
+            };
+        };
+
+        /**
+         * Builds a ball tree over the ground set V.
+         *
+         * @param V The ground set to index.
+         * @param leafSize The maximum number of points stored in a leaf node.
+         */
+        explicit BallTree(const MatrixX<HostDataType>& V, unsigned int leafSize = 32) : _leafSize(std::max(leafSize, 1u)) {
+            // Create the initial ordering.
+            std::vector<unsigned long> order(V.rows());
+            std::iota(order.begin(), order.end(), 0);
+
+            // Build the tree recursively.
+            _nodes.reserve(2 * (V.rows() / _leafSize + 1));
+            _centers.reserve(2 * (V.rows() / _leafSize + 1));
+            if (V.rows() > 0)
+                build(V, order, 0, V.rows());
+
+            // Store the points in tree order, such that every node addresses a contiguous block of rows.
+            _order = std::move(order);
+            _points.resize(V.rows(), V.cols());
+            for (unsigned long i = 0; i < _order.size(); i++)
+                _points.row(i) = V.row(_order[i]);
+        };
+
+        /**
+         * Returns the nodes of the tree. The root node is located at index 0.
+         * @return As stated above.
+         */
+        const std::vector<Node>& getNodes() const {
+            return _nodes;
+        };
+
+        /**
+         * Returns the center of a node.
+         * @param nodeIdx The index of the node.
+         * @return As stated above.
+         */
+        const VectorX<HostDataType>& getCenter(unsigned long nodeIdx) const {
+            return _centers[nodeIdx];
+        };
+
+        /**
+         * Returns the points of the ground set in tree order.
+         * @return As stated above.
+         */
+        const MatrixX<HostDataType>& getPoints() const {
+            return _points;
+        };
+
+        /**
+         * Returns the mapping from tree order to the original row indices of the ground set.
+         * @return As stated above.
+         */
+        const std::vector<unsigned long>& getOrder() const {
+            return _order;
+        };
+
+        /**
+         * Calculates a lower bound for the squared distance between `e` and every point covered by a node.
+         *
+         * @param nodeIdx The index of the node.
+         * @param e The vector to calculate the bound for.
+         * @return A lower bound for \f$\min_{v \in \text{node}} \|v - e\|^2\f$.
+         */
+        template<typename Derived>
+        HostDataType lowerBound(unsigned long nodeIdx, const Eigen::MatrixBase<Derived>& e) const {
+            // Both terms are slightly relaxed, such that rounding errors never cause a bound to exceed the true distance.
+            const HostDataType relax = 4 * std::numeric_limits<HostDataType>::epsilon();
+            HostDataType centerDistance = (_centers[nodeIdx] - e).norm() * (1 - relax) - _nodes[nodeIdx].radius * (1 + relax);
+            return centerDistance > 0 ? centerDistance * centerDistance : 0;
+        };
+
+    private:
+        unsigned int _leafSize;
+        std::vector<Node> _nodes;
+        std::vector<VectorX<HostDataType>> _centers;
+        std::vector<unsigned long> _order;
+        MatrixX<HostDataType> _points;
+
+        /**
+         * Recursively builds the subtree for the points `order[begin:end]`.
+         *
+         * @param V The ground set.
+         * @param order The current ordering of the ground set, which is rearranged in-place.
+         * @param begin First index (inclusive).
+         * @param end Last index (exclusive).
+         * @return The index of the created node.
+         */
+        long build(const MatrixX<HostDataType>& V, std::vector<unsigned long>& order, unsigned long begin, unsigned long end) {
+            // Calculate center and radius.
+            VectorX<HostDataType> center = VectorX<HostDataType>::Zero(V.cols());
+            for (unsigned long i = begin; i < end; i++)
+                center += V.row(order[i]).transpose();
+            center /= static_cast<HostDataType>(end - begin);
+
+            HostDataType radius = 0;
+            for (unsigned long i = begin; i < end; i++)
+                radius = std::max(radius, (V.row(order[i]).transpose() - center).norm());
+
+            // Create the node.
+            long nodeIdx = static_cast<long>(_nodes.size());
+            _nodes.push_back({begin, end, -1, -1, radius});
+            _centers.push_back(center);
+
+            if (end - begin > _leafSize) {
+                // Split along the dimension of largest spread.
+                Eigen::Index splitDim = 0;
+                HostDataType maxSpread = -1;
+                for (Eigen::Index d = 0; d < V.cols(); d++) {
+                    HostDataType minVal = std::numeric_limits<HostDataType>::max();
+                    HostDataType maxVal = std::numeric_limits<HostDataType>::lowest();
+                    for (unsigned long i = begin; i < end; i++) {
+                        minVal = std::min(minVal, V(order[i], d));
+                        maxVal = std::max(maxVal, V(order[i], d));
+                    }
+                    if (maxVal - minVal > maxSpread) {
+                        maxSpread = maxVal - minVal;
+                        splitDim = d;
+                    }
+                }
+
+                // Partition at the median.
+                unsigned long mid = begin + (end - begin) / 2;
+                std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                                 [&](unsigned long a, unsigned long b) { return V(a, splitDim) < V(b, splitDim); });
+
+                // Build the children. Note, that `_nodes` may be reallocated during recursion.
+                long left = build(V, order, begin, mid);
+                long right = build(V, order, mid, end);
+                _nodes[nodeIdx].left = left;
+                _nodes[nodeIdx].right = right;
+            }
+
+            return nodeIdx;
+        };
+    };
+}
+
+#endif // EXEMCL_BALLTREE_H
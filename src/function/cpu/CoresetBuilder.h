@@ -0,0 +1,180 @@
+#ifndef EXEMCL_FUNCTION_CPU_CORESETBUILDER
+#define EXEMCL_FUNCTION_CPU_CORESETBUILDER
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <src/function/cpu/ApproximationValidation.h>
+#include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/RoughClustering.h>
+#include <src/function/cpu/WeightedGroundSet.h>
+
+namespace exemcl::cpu {
+    /**
+     * Summarizes the size and the observed error of a coreset.
+     */
+    struct CoresetReport {
+        unsigned long groundSetSize = 0; // The number of points in V.
+        unsigned long coresetSize = 0;   // The number of (unique) points in the coreset.
+        double epsilon = 0.0;            // The theoretical relative error for the sampled size (without constant factors).
+        double maxRelativeError = 0.0;   // Maximum relative error of f(S) w.r.t. the exact function on the validation sets.
+        double meanRelativeError = 0.0;  // Mean relative error of f(S) w.r.t. the exact function on the validation sets.
+        unsigned int validationSets = 0; // The number of validation sets.
+    };
+
+    /**
+     * Builds weighted coresets of a ground set by sensitivity sampling (see Bachem, Lucic and Krause, "Practical Coreset Constructions for Machine Learning", 2017).
+     *
+     * First, a rough clustering \f$B\f$ of V with \f$k\f$ centers is obtained by \f$D^2\f$ sampling. The sensitivity of every point \f$v\f$ in the cluster \f$B_v\f$
+     * is then bounded by
+     * \f[ s(v) = \alpha \frac{d(v, B)^2}{\bar{c}} + 2 \alpha \frac{\sum_{v' \in B_v} d(v', B)^2}{|B_v| \bar{c}} + \frac{4 |V|}{|B_v|}, \f]
+     * where \f$\bar{c}\f$ denotes the mean of \f$d(v, B)^2\f$ and \f$\alpha = 16 (\log k + 2)\f$. The coreset consists of \f$m\f$ points, which are sampled with
+     * probability \f$q(v) \propto s(v)\f$ and weighted by \f$1 / (m q(v))\f$, such that L (and hence f) is estimated without bias for every set S. Points, which are sampled
+     * multiple times, are merged.
+     *
+     * The resulting `WeightedGroundSet` can be passed directly to `ExemplarClusteringSubmodularFunction`.
+     */
+    template<typename HostDataType = float>
+    class CoresetBuilder {
+    public:
+        /**
+         * Constructs the coreset builder.
+         *
+         * @param clusters The number of centers \f$k\f$ of the rough clustering.
+         * @param seed Seed for the random number generator.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit CoresetBuilder(unsigned int clusters = 16, unsigned long seed = 0, int workerCount = -1) : _clusters(clusters), _seed(seed) {
+            if (clusters == 0)
+                throw std::runtime_error("CoresetBuilder::CoresetBuilder: The number of clusters needs to be positive.");
+            _workerCount = resolveWorkerCount(workerCount);
+        };
+
+        /**
+         * Returns the number of samples, for which the coreset is expected to achieve a relative error of `epsilon` with probability \f$1 - \delta\f$, i.e.
+         * \f$m = (d k \log k + \log(1 / \delta)) / \epsilon^2\f$ (without constant factors).
+         *
+         * @param dim The dimensionality of the ground set.
+         * @param epsilon The relative error.
+         * @param delta The failure probability.
+         * @return As stated above.
+         */
+        unsigned long sizeForEpsilon(unsigned int dim, double epsilon, double delta = 0.05) const {
+            if (epsilon <= 0.0 || delta <= 0.0 || delta >= 1.0)
+                throw std::runtime_error("CoresetBuilder::sizeForEpsilon: Requires epsilon > 0 and 0 < delta < 1.");
+            return static_cast<unsigned long>(std::ceil(complexity(dim, delta) / (epsilon * epsilon)));
+        };
+
+        /**
+         * Builds a coreset of V, which consists of at most `size` points. Validation is opt-in, since it evaluates the exact function over the whole of V, i.e. it costs
+         * what the coreset is meant to save.
+         *
+         * @param V The ground set V.
+         * @param size The number of samples \f$m\f$.
+         * @param validationSets The number of random subsets of V, which are used to measure the error w.r.t. the exact function (defaults to 0, i.e. no validation).
+         * @param delta The failure probability, which is used to report the theoretical error.
+         * @return The weighted coreset.
+         */
+        WeightedGroundSet<HostDataType> build(const MatrixX<HostDataType>& V, unsigned long size, unsigned int validationSets = 0, double delta = 0.05) {
+            if (V.rows() == 0 || size == 0)
+                throw std::runtime_error("CoresetBuilder::build: Requires a non-empty ground set and a positive coreset size.");
+
+            std::mt19937_64 generator(_seed);
+            const unsigned long n = V.rows();
+            const unsigned int k = std::min<unsigned long>(_clusters, n);
+
+            // Obtain the rough clustering and the squared distances to it.
+            std::vector<unsigned int> assignment(n);
+            std::vector<double> squaredDistances(n);
+            roughClustering(V, k, generator, assignment, squaredDistances, _workerCount);
+
+            // Compute the sensitivities.
+            std::vector<double> clusterSizes(k, 0.0), clusterCosts(k, 0.0);
+            double meanCost = 0.0;
+            for (unsigned long i = 0; i < n; i++) {
+                clusterSizes[assignment[i]] += 1.0;
+                clusterCosts[assignment[i]] += squaredDistances[i];
+                meanCost += squaredDistances[i];
+            }
+            meanCost /= static_cast<double>(n);
+
+            const double alpha = 16.0 * (std::log(static_cast<double>(k)) + 2.0);
+            std::vector<double> sensitivities(n);
+#pragma omp parallel for num_threads(_workerCount)
+            for (unsigned long i = 0; i < n; i++) {
+                const unsigned int c = assignment[i];
+                const double distanceTerm = meanCost > 0.0 ? alpha * squaredDistances[i] / meanCost + 2.0 * alpha * clusterCosts[c] / (clusterSizes[c] * meanCost) : 0.0;
+                sensitivities[i] = distanceTerm + 4.0 * static_cast<double>(n) / clusterSizes[c];
+            }
+            double totalSensitivity = 0.0;
+            for (double s : sensitivities)
+                totalSensitivity += s;
+
+            // Sample the coreset and merge points, which are sampled multiple times.
+            std::discrete_distribution<unsigned long> distribution(sensitivities.begin(), sensitivities.end());
+            std::map<unsigned long, double> samples;
+            for (unsigned long j = 0; j < size; j++) {
+                unsigned long i = distribution(generator);
+                samples[i] += totalSensitivity / (static_cast<double>(size) * sensitivities[i]);
+            }
+
+            MatrixX<HostDataType> points(samples.size(), V.cols());
+            VectorX<double> weights(samples.size());
+            unsigned long row = 0;
+            for (auto& [i, weight] : samples) {
+                points.row(row) = V.row(i);
+                weights[row++] = weight;
+            }
+            WeightedGroundSet<HostDataType> coreset(std::move(points), std::move(weights));
+
+            // Fill the report.
+            _report = CoresetReport();
+            _report.groundSetSize = n;
+            _report.coresetSize = coreset.points.rows();
+            _report.epsilon = std::sqrt(complexity(V.cols(), delta) / static_cast<double>(size));
+            if (validationSets > 0) {
+                ExemplarClusteringSubmodularFunction<HostDataType> coresetFunction(coreset, _workerCount);
+                const ApproximationError error = validateApproximation(V, [&](const MatrixX<double>& S) { return coresetFunction(S); }, validationSets, generator, _workerCount);
+                _report.maxRelativeError = error.maxRelativeError;
+                _report.meanRelativeError = error.meanRelativeError;
+                _report.validationSets = error.validationSets;
+            }
+
+            return coreset;
+        };
+
+        /**
+         * Builds a coreset of V, whose theoretical relative error is `epsilon` (see `sizeForEpsilon`).
+         *
+         * @param V The ground set V.
+         * @param epsilon The relative error.
+         * @param delta The failure probability.
+         * @param validationSets The number of random subsets of V, which are used to measure the error w.r.t. the exact function (defaults to 0, see `build`).
+         * @return The weighted coreset.
+         */
+        WeightedGroundSet<HostDataType> buildForEpsilon(const MatrixX<HostDataType>& V, double epsilon, double delta = 0.05, unsigned int validationSets = 0) {
+            return build(V, sizeForEpsilon(V.cols(), epsilon, delta), validationSets, delta);
+        };
+
+        /**
+         * Returns the report of the most recently built coreset.
+         * @return As stated above.
+         */
+        const CoresetReport& getReport() const {
+            return _report;
+        };
+
+    private:
+        unsigned int _clusters;
+        unsigned long _seed;
+        unsigned int _workerCount;
+        CoresetReport _report;
+
+        double complexity(unsigned int dim, double delta) const {
+            const double k = static_cast<double>(_clusters);
+            return static_cast<double>(dim) * k * std::max(std::log(k), 1.0) + std::log(1.0 / delta);
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_CORESETBUILDER
@@ -0,0 +1,239 @@
+#ifndef EXEMCL_DIMENSIONREDUCTION_H
+#define EXEMCL_DIMENSIONREDUCTION_H
+
+#include <cmath>
+#include <random>
+#include <src/io/DataTypes.h>
+
+namespace exemcl::cpu {
+    /**
+     * Describes the method, which is used to reduce the dimensionality of the data.
+     */
+    enum class DimensionReductionMethod {
+        PCA,             // Orthogonal projection onto the leading principal components of V.
+        RandomProjection // Gaussian Johnson-Lindenstrauss projection.
+    };
+
+    /**
+     * A linear map \f$x \mapsto P(x - \mu)\f$, which reduces vectors from \f$d\f$ to \f$k < d\f$ dimensions.
+     *
+     * For PCA, the rows of \f$P\f$ are orthonormal, hence \f$\|x - y\|^2 = \|P(x - y)\|^2 + \|r_x - r_y\|^2\f$, where \f$r_x\f$ denotes the residual of \f$x\f$ w.r.t. the
+     * principal subspace. Since only the residual norms are stored, the remaining term is bounded by \f$(\|r_x\| - \|r_y\|)^2 \leq \|r_x - r_y\|^2 \leq (\|r_x\| + \|r_y\|)^2\f$.
+     *
+     * For random projections, the Johnson-Lindenstrauss lemma guarantees, that all pairwise squared distances among \f$n\f$ points are preserved up to a factor of
+     * \f$(1 \pm \epsilon)\f$ with high probability.
+     */
+    template<typename HostDataType = float>
+    class DimensionReduction {
+    public:
+        /**
+         * Fits a PCA projection to the ground set V.
+         *
+         * @param V The ground set.
+         * @param targetDim The number of principal components to keep.
+         * @param exactResidual If true, functions using this projection keep the full-dimensional data and use the projected distances only for pruning, which makes
+         * all evaluations exact.
+         * @return The PCA projection.
+         */
+        static DimensionReduction pca(const MatrixX<HostDataType>& V, unsigned int targetDim, bool exactResidual = false) {
+            checkTargetDim(V.cols(), targetDim);
+            if (V.rows() == 0)
+                throw std::runtime_error("DimensionReduction::pca: Cannot fit a PCA projection to an empty ground set.");
+
+            // Compute mean and covariance in double precision.
+            MatrixX<double, Eigen::ColMajor> X = V.template cast<double>();
+            VectorX<double> mean = X.colwise().mean().transpose();
+            X.rowwise() -= mean.transpose();
+            MatrixX<double, Eigen::ColMajor> covariance = (X.transpose() * X) / static_cast<double>(V.rows());
+
+            // Eigenvalues are sorted in increasing order, hence we pick the last `targetDim` eigenvectors.
+            Eigen::SelfAdjointEigenSolver<MatrixX<double, Eigen::ColMajor>> solver(covariance);
+            if (solver.info() != Eigen::Success)
+                throw std::runtime_error("DimensionReduction::pca: Eigendecomposition of the covariance matrix failed.");
+            MatrixX<double> P = solver.eigenvectors().rightCols(targetDim).rowwise().reverse().transpose();
+
+            DimensionReduction reduction;
+            reduction._method = DimensionReductionMethod::PCA;
+            reduction._exactResidual = exactResidual;
+            reduction._P = P.cast<HostDataType>();
+            reduction._mean = mean.cast<HostDataType>();
+            return reduction;
+        };
+
+        /**
+         * Creates a Gaussian random projection in the fashion of Johnson and Lindenstrauss.
+         *
+         * @param sourceDim The dimensionality of the original data.
+         * @param targetDim The dimensionality of the projected data.
+         * @param seed Seed for the random number generator.
+         * @return The random projection.
+         */
+        static DimensionReduction randomProjection(unsigned int sourceDim, unsigned int targetDim, unsigned long seed = 0) {
+            checkTargetDim(sourceDim, targetDim);
+
+            std::mt19937_64 generator(seed);
+            std::normal_distribution<double> distribution(0.0, 1.0 / std::sqrt(static_cast<double>(targetDim)));
+
+            DimensionReduction reduction;
+            reduction._method = DimensionReductionMethod::RandomProjection;
+            reduction._P.resize(targetDim, sourceDim);
+            for (unsigned int i = 0; i < targetDim; i++)
+                for (unsigned int j = 0; j < sourceDim; j++)
+                    reduction._P(i, j) = static_cast<HostDataType>(distribution(generator));
+            reduction._mean = VectorX<HostDataType>::Zero(sourceDim);
+            return reduction;
+        };
+
+        /**
+         * Restores a projection from its parameters (see `getProjection` and `getMean`), e.g. when loading a saved function.
+         *
+         * @param method The method of the projection.
+         * @param exactResidual Whether evaluations should use the projected distances for pruning only.
+         * @param P The projection matrix with shape `[targetDim, sourceDim]`.
+         * @param mean The mean, which is subtracted before projecting.
+         * @return The projection.
+         */
+        static DimensionReduction restore(DimensionReductionMethod method, bool exactResidual, const MatrixX<HostDataType>& P, const VectorX<HostDataType>& mean) {
+            checkTargetDim(P.cols(), P.rows());
+            if (mean.size() != P.cols())
+                throw std::runtime_error("DimensionReduction::restore: The dimensionality of the mean does not match the projection (" + std::to_string(mean.size()) + " vs. "
+                                         + std::to_string(P.cols()) + ").");
+
+            DimensionReduction reduction;
+            reduction._method = method;
+            reduction._exactResidual = exactResidual;
+            reduction._P = P;
+            reduction._mean = mean;
+            return reduction;
+        };
+
+        /**
+         * Projects every row of `X` into the reduced space.
+         *
+         * @param X Data matrix with shape `[n, sourceDim]`.
+         * @return Data matrix with shape `[n, targetDim]`.
+         */
+        MatrixX<HostDataType> project(const MatrixX<HostDataType>& X) const {
+            checkSourceDim(X);
+            return (X.rowwise() - _mean.transpose()) * _P.transpose();
+        };
+
+        /**
+         * Calculates the norm of the residual \f$\|(x - \mu) - P^T P (x - \mu)\|\f$ for every row of `X`. Only available for PCA projections.
+         *
+         * @param X Data matrix with shape `[n, sourceDim]`.
+         * @param XProjected The result of `project(X)`.
+         * @return A vector holding the residual norm of every row.
+         */
+        VectorX<HostDataType> residualNorms(const MatrixX<HostDataType>& X, const MatrixX<HostDataType>& XProjected) const {
+            if (_method != DimensionReductionMethod::PCA)
+                throw std::runtime_error("DimensionReduction::residualNorms: Residual norms are only available for PCA projections.");
+            checkSourceDim(X);
+
+            // The residual is computed explicitly rather than via \f$\|x - \mu\|^2 - \|P(x - \mu)\|^2\f$, which suffers from cancellation for small residuals.
+            VectorX<HostDataType> residuals(X.rows());
+            for (Eigen::Index i = 0; i < X.rows(); i++)
+                residuals[i] = ((X.row(i) - _mean.transpose()) - XProjected.row(i) * _P).norm();
+            return residuals;
+        };
+
+        /**
+         * Calculates the distortion \f$\epsilon\f$, for which the Johnson-Lindenstrauss lemma guarantees that the squared distances among `n` points are preserved up to a
+         * factor of \f$(1 \pm \epsilon)\f$ with high probability, i.e. the solution of \f$k = 4 \ln(n) / (\epsilon^2 / 2 - \epsilon^3 / 3)\f$. Returns 1, if the target
+         * dimensionality is too small to provide any guarantee.
+         *
+         * @param n The number of points.
+         * @return As stated above.
+         */
+        double distortion(unsigned long n) const {
+            if (_method == DimensionReductionMethod::PCA)
+                return 0.0;
+
+            double required = 4.0 * std::log(std::max(n, 2ul));
+            auto dimFor = [&](double eps) { return required / (eps * eps / 2.0 - eps * eps * eps / 3.0); };
+            if (dimFor(1.0) > getTargetDim())
+                return 1.0;
+
+            // Bisection, since the required dimensionality is monotonically decreasing in epsilon on (0, 1].
+            double lo = 0.0, hi = 1.0;
+            for (int i = 0; i < 64; i++) {
+                double mid = 0.5 * (lo + hi);
+                if (dimFor(mid) > getTargetDim())
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            return hi;
+        };
+
+        /**
+         * Returns the method of this projection.
+         * @return As stated above.
+         */
+        DimensionReductionMethod getMethod() const {
+            return _method;
+        };
+
+        /**
+         * Returns, whether evaluations should use the projected distances for pruning only (and hence be exact).
+         * @return As stated above.
+         */
+        bool isExactResidual() const {
+            return _exactResidual;
+        };
+
+        /**
+         * Returns the dimensionality of the original data.
+         * @return As stated above.
+         */
+        unsigned int getSourceDim() const {
+            return _P.cols();
+        };
+
+        /**
+         * Returns the dimensionality of the projected data.
+         * @return As stated above.
+         */
+        unsigned int getTargetDim() const {
+            return _P.rows();
+        };
+
+        /**
+         * Returns the projection matrix with shape `[targetDim, sourceDim]`.
+         * @return As stated above.
+         */
+        const MatrixX<HostDataType>& getProjection() const {
+            return _P;
+        };
+
+        /**
+         * Returns the mean, which is subtracted before projecting.
+         * @return As stated above.
+         */
+        const VectorX<HostDataType>& getMean() const {
+            return _mean;
+        };
+
+    private:
+        DimensionReductionMethod _method = DimensionReductionMethod::PCA;
+        bool _exactResidual = false;
+        MatrixX<HostDataType> _P;
+        VectorX<HostDataType> _mean;
+
+        DimensionReduction() = default;
+
+        static void checkTargetDim(unsigned long sourceDim, unsigned int targetDim) {
+            if (targetDim == 0 || targetDim > sourceDim)
+                throw std::runtime_error("DimensionReduction: The target dimensionality needs to be within [1, " + std::to_string(sourceDim) + "], but is "
+                                         + std::to_string(targetDim) + ".");
+        };
+
+        void checkSourceDim(const MatrixX<HostDataType>& X) const {
+            if (X.cols() != _P.cols())
+                throw std::runtime_error("DimensionReduction: The dimensionality of the data does not match the projection (" + std::to_string(X.cols()) + " vs. "
+                                         + std::to_string(_P.cols()) + ").");
+        };
+    };
+}
+
+#endif // EXEMCL_DIMENSIONREDUCTION_H
@@ -0,0 +1,103 @@
+#ifndef EXEMCL_FUNCTION_CPU_DISTANCEKERNELS
+#define EXEMCL_FUNCTION_CPU_DISTANCEKERNELS
+
+#include <algorithm>
+#include <limits>
+#include <src/function/Dissimilarity.h>
+
+namespace exemcl::cpu::kernels {
+    /**
+     * Marks the kernel, whose dimensionality is only known at runtime.
+     */
+    constexpr int DynamicDim = Eigen::Dynamic;
+
+    /**
+     * Computes \f$\min_{s \in S} d(v, s)\f$ for every \f$v \in V\f$, where \f$d\f$ is given by the dissimilarity policy (see `SquaredEuclidean`). `V` and `S` need to be
+     * prepared by the policy already.
+     *
+     * If `Dim` is fixed at compile time, every row is mapped onto a fixed-size Eigen vector. Hence, the dissimilarity computation is fully unrolled and the current row of V
+     * is kept in registers, whilst iterating over the exemplars. Otherwise, the dimensionality is taken from `V`.
+     *
+     * @param V The ground set (one point per row), which may also reference external memory (e.g. a memory-mapped file).
+     * @param S The exemplars (one per row), including the zero vector, which may also reference the leading rows of a larger (reused) buffer.
+     * @param minDistances Output array with `V.rows()` entries.
+     * @param workerCount The number of threads to employ.
+     */
+    template<typename HostDataType, typename Dissimilarity = SquaredEuclidean, int Dim = DynamicDim>
+    void minDissimilarities(ConstMatrixXRef<HostDataType> V, ConstMatrixXRef<HostDataType> S, HostDataType* minDistances, unsigned int workerCount) {
+        using RowType = Eigen::Matrix<HostDataType, 1, Dim>;
+        using ConstRowMap = Eigen::Map<const RowType, Eigen::Unaligned>;
+        const Eigen::Index dim = V.cols();
+        const Eigen::Index stride = V.outerStride();
+        const Eigen::Index exemplarStride = S.outerStride();
+
+#pragma omp parallel for num_threads(workerCount) schedule(static)
+        for (Eigen::Index i = 0; i < V.rows(); i++) {
+            if constexpr (Dim != DynamicDim) {
+                const RowType v = ConstRowMap(V.data() + i * stride);
+                HostDataType min_val = std::numeric_limits<HostDataType>::max();
+                for (Eigen::Index j = 0; j < S.rows(); j++)
+                    min_val = std::min(Dissimilarity::evaluate(v, ConstRowMap(S.data() + j * exemplarStride)), min_val);
+                minDistances[i] = min_val;
+            } else {
+                ConstRowMap v(V.data() + i * stride, dim);
+                HostDataType min_val = std::numeric_limits<HostDataType>::max();
+                for (Eigen::Index j = 0; j < S.rows(); j++)
+                    min_val = std::min(Dissimilarity::evaluate(v, ConstRowMap(S.data() + j * exemplarStride, dim)), min_val);
+                minDistances[i] = min_val;
+            }
+        }
+    }
+
+    /**
+     * Computes \f$\min_{s \in S} 1 - \langle v, s \rangle\f$ for every (normalized) \f$v \in V\f$. Blocks of V are multiplied with \f$S^T\f$ as a matrix product,
+     * which turns the cosine dissimilarity into a cache-blocked GEMM followed by a row-wise maximum.
+     *
+     * @param V The ground set (one point per row), normalized by `Cosine::prepare`.
+     * @param S The exemplars (one per row), normalized by `Cosine::prepare`, including the zero vector.
+     * @param minDistances Output array with `V.rows()` entries.
+     * @param workerCount The number of threads to employ.
+     */
+    template<typename HostDataType>
+    void minCosineDissimilarities(ConstMatrixXRef<HostDataType> V, ConstMatrixXRef<HostDataType> S, HostDataType* minDistances, unsigned int workerCount) {
+        const Eigen::Index blockSize = 1024;
+        const Eigen::Index blockCount = (V.rows() + blockSize - 1) / blockSize;
+        const MatrixX<HostDataType, Eigen::ColMajor> S_transposed = S.transpose();
+
+#pragma omp parallel for num_threads(workerCount) schedule(static)
+        for (Eigen::Index b = 0; b < blockCount; b++) {
+            const Eigen::Index begin = b * blockSize;
+            const Eigen::Index len = std::min(blockSize, V.rows() - begin);
+            MatrixX<HostDataType> similarities = V.middleRows(begin, len) * S_transposed;
+            Eigen::Map<VectorX<HostDataType>>(minDistances + begin, len) = (static_cast<HostDataType>(1) - similarities.rowwise().maxCoeff().array()).matrix();
+        }
+    }
+
+    /**
+     * Dispatches to the specialized kernel for the dimensionality of `V` (2, 3, 8, 16, 32 or 64) and falls back to the dynamic kernel otherwise. The cosine
+     * dissimilarity is always evaluated by the GEMM-based kernel (see `minCosineDissimilarities`).
+     *
+     * @param V The ground set (one point per row).
+     * @param S The exemplars (one per row), including the zero vector.
+     * @param minDistances Output array with `V.rows()` entries.
+     * @param workerCount The number of threads to employ.
+     */
+    template<typename HostDataType, typename Dissimilarity = SquaredEuclidean>
+    void dispatchMinDissimilarities(ConstMatrixXRef<HostDataType> V, ConstMatrixXRef<HostDataType> S, HostDataType* minDistances, unsigned int workerCount) {
+        if constexpr (std::is_same<Dissimilarity, Cosine>::value)
+            minCosineDissimilarities<HostDataType>(V, S, minDistances, workerCount);
+        else {
+            switch (V.cols()) {
+                case 2: return minDissimilarities<HostDataType, Dissimilarity, 2>(V, S, minDistances, workerCount);
+                case 3: return minDissimilarities<HostDataType, Dissimilarity, 3>(V, S, minDistances, workerCount);
+                case 8: return minDissimilarities<HostDataType, Dissimilarity, 8>(V, S, minDistances, workerCount);
+                case 16: return minDissimilarities<HostDataType, Dissimilarity, 16>(V, S, minDistances, workerCount);
+                case 32: return minDissimilarities<HostDataType, Dissimilarity, 32>(V, S, minDistances, workerCount);
+                case 64: return minDissimilarities<HostDataType, Dissimilarity, 64>(V, S, minDistances, workerCount);
+                default: return minDissimilarities<HostDataType, Dissimilarity, DynamicDim>(V, S, minDistances, workerCount);
+            }
+        }
+    }
+}
+
+#endif // EXEMCL_FUNCTION_CPU_DISTANCEKERNELS
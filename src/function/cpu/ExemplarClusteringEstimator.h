@@ -0,0 +1,576 @@
+#ifndef EXEMCL_FUNCTION_CPU_ESTIMATOR
+#define EXEMCL_FUNCTION_CPU_ESTIMATOR
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <src/function/Dissimilarity.h>
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/GroundSet.h>
+#include <src/function/cpu/RoughClustering.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * Selects, which points of V are used to estimate L.
+     */
+    enum class SamplingScheme {
+        Random,     // Points are drawn uniformly (with replacement), independently for every evaluation.
+        Stratified, // V is partitioned into strata by a rough clustering. The prefix of a fixed permutation of every stratum is used, proportionally to the stratum size.
+        Permuted    // The prefix of a fixed permutation of V is used.
+    };
+
+    /**
+     * An estimate of \f$f(S)\f$ alongside its confidence interval.
+     */
+    struct FunctionEstimate {
+        double value = 0.0;        // The estimate of f(S).
+        double lower = 0.0;        // The lower end of the confidence interval.
+        double upper = 0.0;        // The upper end of the confidence interval.
+        unsigned long samples = 0; // The number of points of V, which have been evaluated.
+        bool exact = false;        // True, if every point of V has been evaluated (and hence value equals f(S)).
+
+        /**
+         * Returns the width of the confidence interval.
+         * @return As stated above.
+         */
+        double width() const {
+            return upper - lower;
+        };
+    };
+
+    /**
+     * Holds the outcome of a racing-based candidate selection.
+     */
+    struct RacingResult {
+        std::vector<unsigned long> indices; // Indices of the best candidates (in descending order of their gains).
+        std::vector<double> gains;          // The exact marginal gain of every selected candidate.
+        unsigned long survivors = 0;        // The number of candidates, which have been evaluated on all of V.
+        unsigned long evaluations = 0;      // The number of evaluated (candidate, point) pairs.
+    };
+
+    /**
+     * This class estimates the submodular function of exemplar-based clustering by evaluating L on a sample of V only, which is useful to screen candidates cheaply.
+     *
+     * \f$L({0})\f$ is computed exactly once, whereas \f$L(S \cup \{0\})\f$ is estimated by the (stratified) mean of the minimal dissimilarities of the sampled points. The
+     * confidence interval follows from the central limit theorem, using the finite population correction for samples without replacement. For the permuted and the
+     * stratified scheme, V is reordered once by a fixed permutation, such that every evaluation uses the same points (which makes estimates of different sets comparable)
+     * and the sampled prefix is read contiguously.
+     *
+     * The reordered V is held as a shared `GroundSet`, over which the exact function (see `getFunction`) is evaluated as well, hence both modes share a single copy of
+     * V. The sampled points are evaluated by the distance kernels of `ExemplarClusteringSubmodularFunction` and summed up according to the reduction mode.
+     *
+     * Evaluating the function via `operator()` yields the point estimate for the configured number of samples, hence the estimator can be used in place of the exact
+     * function (e.g. as the fast function of `MixedPrecisionGreedy`).
+     */
+    template<typename HostDataType = float, typename Dissimilarity = SquaredEuclidean>
+    class ExemplarClusteringEstimator : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+
+        /**
+         * Constructs the estimator using a ground set V.
+         *
+         * @param V The ground set V.
+         * @param scheme The sampling scheme.
+         * @param sampleCount The number of samples, which is used by `operator()`.
+         * @param strata The number of strata (only used by the stratified scheme).
+         * @param seed Seed for the permutation and the random samples.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare V and all evaluated sets.
+         */
+        explicit ExemplarClusteringEstimator(const MatrixX<HostDataType>& V, SamplingScheme scheme = SamplingScheme::Permuted, unsigned long sampleCount = 1024,
+                                             unsigned int strata = 16, unsigned long seed = 0, int workerCount = -1, const Dissimilarity& dissimilarity = Dissimilarity()) :
+            SubmodularFunction(workerCount),
+            _scheme(scheme), _seed(seed), _dissimilarity(dissimilarity) {
+            if (V.rows() == 0)
+                throw std::runtime_error("ExemplarClusteringEstimator::ExemplarClusteringEstimator: Requires a non-empty ground set.");
+            if (scheme == SamplingScheme::Stratified && strata == 0)
+                throw std::runtime_error("ExemplarClusteringEstimator::ExemplarClusteringEstimator: The number of strata needs to be positive.");
+            setSampleCount(sampleCount);
+
+            // Determine the order of the points and the strata.
+            const unsigned long n = V.rows();
+            std::mt19937_64 generator(seed);
+            std::vector<unsigned long> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            _strataOffsets = {0, n};
+
+            if (scheme == SamplingScheme::Stratified) {
+                const unsigned int k = std::min<unsigned long>(strata, n);
+                std::vector<unsigned int> assignment(n);
+                std::vector<double> squaredDistances(n);
+                roughClustering(V, k, generator, assignment, squaredDistances, _workerCount);
+                std::stable_sort(order.begin(), order.end(), [&assignment](unsigned long a, unsigned long b) { return assignment[a] < assignment[b]; });
+
+                // Empty clusters (e.g. due to duplicate centers) do not form a stratum.
+                _strataOffsets = {0};
+                for (unsigned long i = 1; i <= n; i++)
+                    if (i == n || assignment[order[i]] != assignment[order[i - 1]])
+                        _strataOffsets.push_back(i);
+            }
+            if (scheme != SamplingScheme::Random)
+                for (unsigned long h = 0; h + 1 < _strataOffsets.size(); h++)
+                    std::shuffle(order.begin() + _strataOffsets[h], order.begin() + _strataOffsets[h + 1], generator);
+
+            // The ground set (and hence L({0}), which is computed exactly) is prepared in the permuted order.
+            MatrixX<HostDataType> permuted(n, V.cols());
+#pragma omp parallel for num_threads(_workerCount)
+            for (unsigned long i = 0; i < n; i++)
+                permuted.row(i) = V.row(order[i]);
+            _groundSet = GroundSet<HostDataType>::template create<Dissimilarity>(std::move(permuted), _dissimilarity, _workerCount);
+            _function = std::make_unique<ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity>>(_groundSet, _workerCount, _dissimilarity);
+        };
+
+        /**
+         * Evaluates the estimate of the exemplar cluster-submodular function for the configured number of samples (see `setSampleCount`).
+         *
+         * @param S The set to evaluate.
+         * @return The estimated submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const ExemplarClusteringEstimator*) (this))->operator()(S);
+        };
+
+        /**
+         * Evaluates the estimate of the exemplar cluster-submodular function for the configured number of samples (see `setSampleCount`).
+         *
+         * @param S The set to evaluate.
+         * @return The estimated submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            return estimate(S, _sampleCount).value;
+        };
+
+        /**
+         * Estimates \f$f(S)\f$ using a fixed number of samples.
+         *
+         * @param S The set to evaluate.
+         * @param samples The number of points of V to evaluate (capped at \f$|V|\f$).
+         * @param confidence The confidence level of the interval.
+         * @return The estimate and its confidence interval.
+         */
+        FunctionEstimate estimate(const MatrixX<double>& S, unsigned long samples, double confidence = 0.95) const {
+            const double z = normalQuantile(confidence);
+            Evaluation evaluation = beginEvaluation(S);
+            extend(evaluation, samples);
+            return summarize(evaluation, z);
+        };
+
+        /**
+         * Estimates \f$f(S)\f$ progressively. The number of samples is doubled (reusing all previously evaluated points), until the width of the confidence interval
+         * drops below `targetWidth`, the time budget is exhausted or every point has been evaluated.
+         *
+         * @param S The set to evaluate.
+         * @param targetWidth The desired width of the confidence interval (0 refines until the time budget is exhausted or the estimate is exact).
+         * @param timeBudget The time budget in seconds (0 disables the budget).
+         * @param confidence The confidence level of the interval.
+         * @param initialSamples The number of samples of the first round (0 selects the configured number of samples).
+         * @return The final estimate and its confidence interval.
+         */
+        FunctionEstimate refine(const MatrixX<double>& S, double targetWidth, double timeBudget = 0.0, double confidence = 0.95, unsigned long initialSamples = 0) const {
+            if (targetWidth < 0.0 || timeBudget < 0.0)
+                throw std::runtime_error("ExemplarClusteringEstimator::refine: The target width and the time budget must not be negative.");
+            const double z = normalQuantile(confidence);
+            const auto start = std::chrono::steady_clock::now();
+
+            Evaluation evaluation = beginEvaluation(S);
+            unsigned long samples = initialSamples > 0 ? initialSamples : _sampleCount;
+            while (true) {
+                extend(evaluation, samples);
+                FunctionEstimate result = summarize(evaluation, z);
+
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (result.exact || result.width() <= targetWidth || (timeBudget > 0.0 && elapsed >= timeBudget) || samples >= _groundSet->rows())
+                    return result;
+                samples *= 2;
+            }
+        };
+
+        /**
+         * Selects the `k` candidates with the largest marginal gains \f$\Delta(e \mid S)\f$ by racing. The gains of all candidates are estimated on a growing prefix of the
+         * (fixed) permutation of V, whose size is doubled in every round. After every round, candidates, whose upper confidence bound falls below the `k`-th largest
+         * lower confidence bound, are dropped. Once at most `k` candidates survive (or the next prefix would cover V), the survivors are evaluated on all of V by the
+         * batched gains of the exact function (see `getFunction`) and ranked by their exact gains.
+         *
+         * The minimal dissimilarities w.r.t. \f$S \cup \{0\}\f$ are computed once per sampled point and shared by all candidates, hence the gain of a candidate only
+         * requires a single dissimilarity per point. The confidence is split among all candidates and all \f$\lceil \log_2(|V| / n_0) \rceil\f$ rounds (union bound),
+         * where \f$n_0\f$ denotes the number of samples of the first round. Requires the permuted or the stratified scheme.
+         *
+         * @param S The current set.
+         * @param candidates The candidates (one per row).
+         * @param k The number of candidates to select.
+         * @param confidence The probability, that no candidate is dropped wrongly.
+         * @param initialSamples The number of samples of the first round (0 selects the configured number of samples).
+         * @return The best candidates alongside their exact gains.
+         */
+        RacingResult topCandidates(const MatrixX<double>& S, const MatrixX<double>& candidates, unsigned int k, double confidence = 0.95, unsigned long initialSamples = 0) const {
+            if (_scheme == SamplingScheme::Random)
+                throw std::runtime_error("ExemplarClusteringEstimator::topCandidates: Racing requires the permuted or the stratified scheme.");
+            if (k == 0 || k > candidates.rows())
+                throw std::runtime_error("ExemplarClusteringEstimator::topCandidates: Cannot select " + std::to_string(k) + " out of " + std::to_string(candidates.rows())
+                                         + " candidates.");
+            if (candidates.cols() != static_cast<Eigen::Index>(_groundSet->cols()))
+                throw std::runtime_error("ExemplarClusteringEstimator::topCandidates: The dimensionality of `candidates` does not match the ground set ("
+                                         + std::to_string(candidates.cols()) + " vs. " + std::to_string(_groundSet->cols()) + ").");
+            auto V = _groundSet->matrix();
+            const unsigned long n = V.rows();
+            unsigned long samples = initialSamples > 0 ? initialSamples : _sampleCount;
+
+            // The confidence is split among all candidates and all rounds, i.e. the prefix sizes from `samples` to (excluding) n (union bound).
+            unsigned long rounds = 0;
+            for (unsigned long prefix = samples; prefix < n; prefix *= 2)
+                rounds++;
+            const double z = normalQuantile(1.0 - (1.0 - confidence) / (static_cast<double>(candidates.rows()) * static_cast<double>(std::max<unsigned long>(rounds, 1))));
+
+            Evaluation evaluation = beginEvaluation(S);
+            MatrixX<HostDataType> E = candidates.cast<HostDataType>();
+            _dissimilarity.prepare(E);
+
+            const unsigned long strataCount = _strataOffsets.size() - 1;
+            VectorX<HostDataType> curMin(n);
+            std::vector<unsigned long> counts(strataCount, 0);
+            std::vector<std::vector<StratumState>> states(E.rows(), std::vector<StratumState>(strataCount));
+            std::vector<unsigned long> alive(E.rows());
+            std::iota(alive.begin(), alive.end(), 0);
+
+            RacingResult result;
+            while (samples < n && alive.size() > k) {
+                const std::vector<unsigned long> targets = allocate(samples);
+
+                // Compute the minimal dissimilarities of the new points once for all candidates.
+                for (unsigned long h = 0; h < strataCount; h++) {
+                    const unsigned long begin = _strataOffsets[h] + counts[h], length = targets[h] - counts[h];
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(V.middleRows(begin, length), evaluation.S, curMin.data() + begin, _workerCount);
+                }
+
+                // Accumulate the per-point improvements of the remaining candidates.
+#pragma omp parallel num_threads(_workerCount)
+                {
+                    VectorX<HostDataType> distances;
+                    VectorX<double> improvements;
+#pragma omp for schedule(dynamic)
+                    for (unsigned long c = 0; c < alive.size(); c++) {
+                        for (unsigned long h = 0; h < strataCount; h++) {
+                            const unsigned long begin = _strataOffsets[h] + counts[h], length = targets[h] - counts[h];
+                            distances.resize(length);
+                            kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(V.middleRows(begin, length), E.middleRows(alive[c], 1), distances.data(), 1);
+                            improvements = (curMin.segment(begin, length) - distances).template cast<double>().cwiseMax(0.0);
+                            accumulate(improvements, states[alive[c]][h], 1);
+                            states[alive[c]][h].count = targets[h];
+                        }
+                    }
+                }
+                for (unsigned long h = 0; h < strataCount; h++) {
+                    result.evaluations += (targets[h] - counts[h]) * alive.size();
+                    counts[h] = targets[h];
+                }
+
+                // Drop all candidates, which are worse than the k-th best candidate with high probability.
+                std::vector<double> lower(alive.size()), upper(alive.size());
+                for (unsigned long c = 0; c < alive.size(); c++) {
+                    auto [mean, variance] = combine(states[alive[c]]);
+                    lower[c] = mean - z * std::sqrt(variance);
+                    upper[c] = mean + z * std::sqrt(variance);
+                }
+                std::vector<double> sortedLower = lower;
+                std::nth_element(sortedLower.begin(), sortedLower.begin() + (k - 1), sortedLower.end(), std::greater<double>());
+                const double threshold = sortedLower[k - 1];
+                std::vector<unsigned long> survivors;
+                for (unsigned long c = 0; c < alive.size(); c++)
+                    if (upper[c] >= threshold)
+                        survivors.push_back(alive[c]);
+                alive = std::move(survivors);
+                samples *= 2;
+            }
+
+            // Evaluate the survivors on all of V by the batched gains of the exact function.
+            MatrixX<double> survivingCandidates(alive.size(), candidates.cols());
+            std::vector<VectorXRef<double>> elems;
+            for (unsigned long c = 0; c < alive.size(); c++) {
+                survivingCandidates.row(c) = candidates.row(alive[c]);
+                elems.emplace_back(survivingCandidates.row(c));
+            }
+            const std::vector<double> gains = (*_function)(S, elems);
+            result.evaluations += alive.size() * n;
+
+            // Rank the survivors by their exact gains. Ties are broken in favor of the lower index.
+            std::vector<std::pair<double, unsigned long>> ranking;
+            for (unsigned long c = 0; c < alive.size(); c++)
+                ranking.emplace_back(gains[c], alive[c]);
+            std::sort(ranking.begin(), ranking.end(), [](const auto& a, const auto& b) { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+            result.survivors = alive.size();
+            for (unsigned long r = 0; r < std::min<unsigned long>(k, ranking.size()); r++) {
+                result.indices.push_back(ranking[r].second);
+                result.gains.push_back(ranking[r].first);
+            }
+            return result;
+        };
+
+        /**
+         * Selects the candidate with the largest marginal gain by racing (see `topCandidates`).
+         *
+         * @param S The current set.
+         * @param candidates The candidates (one per row).
+         * @param confidence The probability, that no candidate is dropped wrongly.
+         * @param initialSamples The number of samples of the first round (0 selects the configured number of samples).
+         * @return The best candidate alongside its exact gain.
+         */
+        RacingResult bestCandidate(const MatrixX<double>& S, const MatrixX<double>& candidates, double confidence = 0.95, unsigned long initialSamples = 0) const {
+            return topCandidates(S, candidates, 1, confidence, initialSamples);
+        };
+
+        /**
+         * Returns the number of samples, which is used by `operator()`.
+         * @return As stated above.
+         */
+        unsigned long getSampleCount() const {
+            return _sampleCount;
+        };
+
+        /**
+         * Updates the number of samples, which is used by `operator()`.
+         * @param sampleCount New number of samples.
+         */
+        void setSampleCount(unsigned long sampleCount) {
+            if (sampleCount == 0)
+                throw std::runtime_error("ExemplarClusteringEstimator::setSampleCount: The number of samples needs to be positive.");
+            _sampleCount = sampleCount;
+        };
+
+        /**
+         * Returns the sampling scheme.
+         * @return As stated above.
+         */
+        SamplingScheme getScheme() const {
+            return _scheme;
+        };
+
+        /**
+         * Returns the (prepared) ground set in the order of the fixed permutation.
+         * @return As stated above.
+         */
+        const std::shared_ptr<const GroundSet<HostDataType>>& getGroundSet() const {
+            return _groundSet;
+        };
+
+        /**
+         * Returns the exact function, which is evaluated over the same ground set (without any copy of V) and shares the settings of the estimator.
+         * @return As stated above.
+         */
+        const ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity>& getFunction() const {
+            return *_function;
+        };
+
+        /**
+         * Updates the worker count of the estimator and the exact function (see `SubmodularFunction::setWorkerCount`).
+         *
+         * @param workerCount New worker count.
+         */
+        void setWorkerCount(int workerCount) override {
+            SubmodularFunction::setWorkerCount(workerCount);
+            if (_function)
+                _function->setWorkerCount(workerCount);
+        };
+
+        /**
+         * Updates the reduction mode of the estimator and the exact function (see `SubmodularFunction::setReductionMode`).
+         *
+         * @param reductionMode New reduction mode.
+         */
+        void setReductionMode(ReductionMode reductionMode) override {
+            SubmodularFunction::setReductionMode(reductionMode);
+            _function->setReductionMode(reductionMode);
+        };
+
+        /**
+         * Enables or disables deterministic evaluation of the estimator and the exact function (see `SubmodularFunction::setDeterministic`).
+         *
+         * @param deterministic True, if results need to be independent of the worker count.
+         */
+        void setDeterministic(bool deterministic) override {
+            SubmodularFunction::setDeterministic(deterministic);
+            _function->setDeterministic(deterministic);
+        };
+
+        /**
+         * Returns the number of strata (1 for the permuted and the random scheme).
+         * @return As stated above.
+         */
+        unsigned long getStrataCount() const {
+            return _strataOffsets.size() - 1;
+        };
+
+    private:
+        /**
+         * Accumulates the minimal dissimilarities of the points of one stratum, which have been evaluated so far.
+         */
+        struct StratumState {
+            unsigned long count = 0;
+            double sum = 0.0;
+            double sumSquares = 0.0;
+        };
+
+        /**
+         * The state of a single (progressive) evaluation.
+         */
+        struct Evaluation {
+            MatrixX<HostDataType> S;
+            std::vector<StratumState> strata;
+            std::mt19937_64 generator;
+        };
+
+        SamplingScheme _scheme;
+        unsigned long _sampleCount;
+        unsigned long _seed;
+        Dissimilarity _dissimilarity;
+        std::shared_ptr<const GroundSet<HostDataType>> _groundSet;
+        std::unique_ptr<ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity>> _function;
+        std::vector<unsigned long> _strataOffsets;
+        mutable std::atomic<unsigned long> _evaluationCount {0};
+
+        /**
+         * Prepares S, appends the zero vector and initializes the strata. Random samples are drawn from a separate stream for every evaluation.
+         */
+        Evaluation beginEvaluation(const MatrixX<double>& S) const {
+            if (S.cols() != static_cast<Eigen::Index>(_groundSet->cols()))
+                throw std::runtime_error("ExemplarClusteringEstimator::estimate: The dimensionality of `S` does not match the ground set (" + std::to_string(S.cols()) + " vs. "
+                                         + std::to_string(_groundSet->cols()) + ").");
+            Evaluation evaluation;
+            evaluation.S = S.cast<HostDataType>();
+            _dissimilarity.prepare(evaluation.S);
+            evaluation.S.conservativeResize(evaluation.S.rows() + 1, Eigen::NoChange_t());
+            evaluation.S.row(evaluation.S.rows() - 1).setZero();
+
+            evaluation.strata.resize(_strataOffsets.size() - 1);
+            if (_scheme == SamplingScheme::Random) {
+                std::seed_seq sequence {_seed, _evaluationCount.fetch_add(1) + 1};
+                evaluation.generator.seed(sequence);
+            }
+            return evaluation;
+        };
+
+        /**
+         * Adds values (and their squares) to the state of a stratum, summed up according to the reduction mode.
+         */
+        void accumulate(const VectorX<double>& values, StratumState& state, unsigned int workerCount) const {
+            VectorX<double> squares = values.array().square();
+            state.sum += reduceSum(values.data(), values.size(), _reductionMode, workerCount, _deterministic);
+            state.sumSquares += reduceSum(squares.data(), squares.size(), _reductionMode, workerCount, _deterministic);
+        };
+
+        /**
+         * Allocates `samples` points (capped at \f$|V|\f$) to the strata proportionally to their sizes, such that every stratum receives at least two points (if possible).
+         */
+        std::vector<unsigned long> allocate(unsigned long samples) const {
+            const unsigned long n = _groundSet->rows();
+            samples = std::min(samples, n);
+            std::vector<unsigned long> targets(_strataOffsets.size() - 1);
+            for (unsigned long h = 0; h < targets.size(); h++) {
+                const unsigned long size = _strataOffsets[h + 1] - _strataOffsets[h];
+                unsigned long target = std::llround(static_cast<double>(samples) * static_cast<double>(size) / static_cast<double>(n));
+                targets[h] = samples == n ? size : std::min(std::max<unsigned long>(target, std::min<unsigned long>(2, size)), size);
+            }
+            return targets;
+        };
+
+        /**
+         * Returns the (stratified) estimate of the mean over V and the variance of the estimate.
+         */
+        std::pair<double, double> combine(const std::vector<StratumState>& strata) const {
+            const double n = static_cast<double>(_groundSet->rows());
+            double mean = 0.0, variance = 0.0;
+            for (unsigned long h = 0; h < strata.size(); h++) {
+                const StratumState& state = strata[h];
+                const double size = static_cast<double>(_strataOffsets[h + 1] - _strataOffsets[h]);
+                const double count = static_cast<double>(state.count);
+                const double weight = size / n;
+                const double stratumMean = state.sum / count;
+                mean += weight * stratumMean;
+
+                if ((_scheme == SamplingScheme::Random || state.count < size) && state.count > 1) {
+                    const double sampleVariance = std::max(state.sumSquares - count * stratumMean * stratumMean, 0.0) / (count - 1.0);
+                    const double correction = _scheme == SamplingScheme::Random ? 1.0 : 1.0 - count / size;
+                    variance += weight * weight * sampleVariance / count * correction;
+                }
+            }
+            return {mean, variance};
+        };
+
+        /**
+         * Extends the evaluation to (at least) `samples` points, which are allocated proportionally to the strata sizes.
+         */
+        void extend(Evaluation& evaluation, unsigned long samples) const {
+            auto V = _groundSet->matrix();
+            const unsigned long n = V.rows();
+            const std::vector<unsigned long> targets = allocate(samples);
+
+            for (unsigned long h = 0; h < evaluation.strata.size(); h++) {
+                StratumState& state = evaluation.strata[h];
+                const unsigned long begin = _strataOffsets[h], target = targets[h];
+                if (target <= state.count)
+                    continue;
+
+                VectorX<HostDataType> distances(target - state.count);
+                if (_scheme == SamplingScheme::Random) {
+                    // Gather the sampled points, such that they are evaluated by a single kernel call.
+                    std::uniform_int_distribution<unsigned long> distribution(0, n - 1);
+                    MatrixX<HostDataType> points(distances.size(), V.cols());
+                    for (Eigen::Index i = 0; i < points.rows(); i++)
+                        points.row(i) = V.row(distribution(evaluation.generator));
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(points, evaluation.S, distances.data(), _workerCount);
+                } else {
+                    // The next points of the fixed permutation are stored contiguously.
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(V.middleRows(begin + state.count, distances.size()), evaluation.S, distances.data(),
+                                                                                    _workerCount);
+                }
+                accumulate(distances.template cast<double>(), state, _workerCount);
+                state.count = target;
+            }
+        };
+
+        /**
+         * Combines the strata into the estimate of f(S) and its confidence interval.
+         */
+        FunctionEstimate summarize(const Evaluation& evaluation, double z) const {
+            FunctionEstimate result;
+            result.exact = _scheme != SamplingScheme::Random;
+            for (unsigned long h = 0; h < evaluation.strata.size(); h++) {
+                result.samples += evaluation.strata[h].count;
+                if (evaluation.strata[h].count < _strataOffsets[h + 1] - _strataOffsets[h])
+                    result.exact = false;
+            }
+
+            auto [L, variance] = combine(evaluation.strata);
+            const double halfWidth = z * std::sqrt(variance);
+            result.value = _groundSet->getZeroVecValue() - L;
+            result.lower = result.value - halfWidth;
+            result.upper = result.value + halfWidth;
+            return result;
+        };
+
+        /**
+         * Returns the quantile \f$z\f$ of the standard normal distribution, such that \f$P(|X| \leq z) = \f$ `confidence`.
+         */
+        static double normalQuantile(double confidence) {
+            if (confidence <= 0.0 || confidence >= 1.0)
+                throw std::runtime_error("ExemplarClusteringEstimator::estimate: The confidence needs to be in (0, 1).");
+            double low = 0.0, high = 40.0;
+            for (unsigned int i = 0; i < 100; i++) {
+                double mid = 0.5 * (low + high);
+                if (std::erf(mid / std::sqrt(2.0)) < confidence)
+                    low = mid;
+                else
+                    high = mid;
+            }
+            return 0.5 * (low + high);
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_ESTIMATOR
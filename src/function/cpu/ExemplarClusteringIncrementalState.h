@@ -0,0 +1,210 @@
+#ifndef EXEMCL_EXEMPLARCLUSTERINGINCREMENTALSTATE_H
+#define EXEMCL_EXEMPLARCLUSTERINGINCREMENTALSTATE_H
+
+#include <src/function/cpu/BallTree.h>
+#include <src/function/SubmodularFunction.h>
+
+namespace exemcl::cpu {
+    /**
+     * This class keeps track of an exemplar set \f$S\f$, which grows incrementally (e.g. during greedy optimization), and provides the submodular function of exemplar-based
+     * clustering w.r.t. this set.
+     *
+     * For every \f$v \in V\f$, the current minimal distance \f$\text{curMin}(v) = \min_{s \in S \cup \{0\}} \|v - s\|^2\f$ is maintained. Adding an exemplar \f$e\f$ only
+     * changes those \f$v\f$ with \f$\|v - e\|^2 < \text{curMin}(v)\f$. The ground set is indexed by a ball tree, in which every node additionally stores the maximum
+     * \f$\text{curMin}\f$ of its points. Hence, computing \f$\Delta(e \mid S)\f$ and applying \f$S \leftarrow S \cup \{e\}\f$ only visit nodes, which `e` can improve.
+     */
+    template<typename HostDataType = float>
+    class ExemplarClusteringIncrementalState {
+    public:
+        /**
+         * Constructs the incremental state for the empty set \f$S = \emptyset\f$.
+         *
+         * @param V The ground set V.
+         * @param leafSize The maximum number of points stored in a leaf node of the ball tree.
+         * @param workerCount The number of workers to employ for batched gain computations (defaults to -1, i.e. all available cores).
+         */
+        explicit ExemplarClusteringIncrementalState(const MatrixX<HostDataType>& V, unsigned int leafSize = 32, int workerCount = -1) : _tree(V, leafSize) {
+            _workerCount = resolveWorkerCount(workerCount);
+
+            // The zero vector value equals the initial L value.
+            _zeroVecValue = 0.0;
+            for (Eigen::Index i = 0; i < V.rows(); i++)
+                _zeroVecValue += V.row(i).squaredNorm();
+            _zeroVecValue /= static_cast<double>(std::max<Eigen::Index>(V.rows(), 1));
+
+            reset();
+        };
+
+        /**
+         * Resets the state to the empty set \f$S = \emptyset\f$.
+         */
+        void reset() {
+            const auto& points = _tree.getPoints();
+            _curMin.resize(points.rows());
+            for (Eigen::Index i = 0; i < points.rows(); i++)
+                _curMin[i] = points.row(i).squaredNorm();
+
+            _nodeMaxCurMin.assign(_tree.getNodes().size(), 0);
+            if (!_tree.getNodes().empty())
+                refreshNode(0);
+
+            _L = _zeroVecValue;
+            _size = 0;
+        };
+
+        /**
+         * Returns the function value \f$f(S)\f$ of the current set.
+         * @return As stated above.
+         */
+        double value() const {
+            return _zeroVecValue - _L;
+        };
+
+        /**
+         * Returns the number of exemplars, which have been added to the set.
+         * @return As stated above.
+         */
+        unsigned long size() const {
+            return _size;
+        };
+
+        /**
+         * Calculates the marginal gain \f$\Delta(e \mid S)\f$ w.r.t. the current set without altering the state.
+         *
+         * @param elem The marginal element.
+         * @return The marginal gain.
+         */
+        double gain(ConstVectorXRef<double> elem) const {
+            checkDimension(elem);
+            VectorX<HostDataType> e = elem.cast<HostDataType>();
+            return _tree.getNodes().empty() ? 0.0 : gainNode(0, e) / static_cast<double>(_curMin.size());
+        };
+
+        /**
+         * Calculates the marginal gains \f$\Delta(e_1 \mid S), ..., \Delta(e_n \mid S)\f$ w.r.t. the current set without altering the state.
+         *
+         * @param elems A set of marginal elements.
+         * @return A set of marginal gains.
+         */
+        std::vector<double> gain(const std::vector<ConstVectorXRef<double>>& elems) const {
+            std::vector<double> gains(elems.size());
+
+#pragma omp parallel for num_threads(_workerCount)
+            for (unsigned long i = 0; i < elems.size(); i++)
+                gains[i] = gain(elems[i]);
+
+            return gains;
+        };
+
+        /**
+         * Adds the element `elem` to the set, i.e. \f$S \leftarrow S \cup \{e\}\f$.
+         *
+         * @param elem The element to add.
+         * @return The marginal gain \f$\Delta(e \mid S)\f$ realized by adding `elem`.
+         */
+        double add(ConstVectorXRef<double> elem) {
+            checkDimension(elem);
+            VectorX<HostDataType> e = elem.cast<HostDataType>();
+            double gain = _tree.getNodes().empty() ? 0.0 : addNode(0, e) / static_cast<double>(_curMin.size());
+            _L -= gain;
+            _size++;
+            return gain;
+        };
+
+        /**
+         * Returns the current minimal distances in ground set order.
+         * @return As stated above.
+         */
+        VectorX<HostDataType> getCurrentMinimums() const {
+            const auto& order = _tree.getOrder();
+            VectorX<HostDataType> curMin(_curMin.size());
+            for (unsigned long i = 0; i < order.size(); i++)
+                curMin[order[i]] = _curMin[i];
+            return curMin;
+        };
+
+    private:
+        BallTree<HostDataType> _tree;
+        std::vector<HostDataType> _curMin;
+        std::vector<HostDataType> _nodeMaxCurMin;
+        double _zeroVecValue;
+        double _L;
+        unsigned long _size;
+        unsigned int _workerCount = 1;
+
+        void checkDimension(ConstVectorXRef<double> elem) const {
+            if (elem.size() != _tree.getPoints().cols())
+                throw std::runtime_error("ExemplarClusteringIncrementalState: The dimensionality of the element does not match the ground set (" + std::to_string(elem.size())
+                                         + " vs. " + std::to_string(_tree.getPoints().cols()) + ").");
+        };
+
+        /**
+         * Recomputes the maximum current minimum of a node from its children (or its points, if the node is a leaf).
+         * @param nodeIdx The node to refresh.
+         */
+        void refreshNode(unsigned long nodeIdx) {
+            const auto& node = _tree.getNodes()[nodeIdx];
+            if (node.isLeaf()) {
+                HostDataType maxVal = 0;
+                for (unsigned long i = node.begin; i < node.end; i++)
+                    maxVal = std::max(maxVal, _curMin[i]);
+                _nodeMaxCurMin[nodeIdx] = maxVal;
+            } else {
+                refreshNode(node.left);
+                refreshNode(node.right);
+                _nodeMaxCurMin[nodeIdx] = std::max(_nodeMaxCurMin[node.left], _nodeMaxCurMin[node.right]);
+            }
+        };
+
+        /**
+         * Sums up the improvements \f$\max(0, \text{curMin}(v) - \|v - e\|^2)\f$ within a subtree. Subtrees, which `e` cannot improve, are skipped.
+         */
+        double gainNode(unsigned long nodeIdx, const VectorX<HostDataType>& e) const {
+            if (_tree.lowerBound(nodeIdx, e) >= _nodeMaxCurMin[nodeIdx])
+                return 0.0;
+
+            const auto& node = _tree.getNodes()[nodeIdx];
+            if (node.isLeaf()) {
+                const auto& points = _tree.getPoints();
+                double accu = 0.0;
+                for (unsigned long i = node.begin; i < node.end; i++) {
+                    HostDataType distance = (points.row(i) - e.transpose()).squaredNorm();
+                    if (distance < _curMin[i])
+                        accu += _curMin[i] - distance;
+                }
+                return accu;
+            } else
+                return gainNode(node.left, e) + gainNode(node.right, e);
+        };
+
+        /**
+         * Applies the improvements of `e` within a subtree and updates the maximum current minimums on the way back up.
+         */
+        double addNode(unsigned long nodeIdx, const VectorX<HostDataType>& e) {
+            if (_tree.lowerBound(nodeIdx, e) >= _nodeMaxCurMin[nodeIdx])
+                return 0.0;
+
+            const auto& node = _tree.getNodes()[nodeIdx];
+            double accu = 0.0;
+            if (node.isLeaf()) {
+                const auto& points = _tree.getPoints();
+                HostDataType maxVal = 0;
+                for (unsigned long i = node.begin; i < node.end; i++) {
+                    HostDataType distance = (points.row(i) - e.transpose()).squaredNorm();
+                    if (distance < _curMin[i]) {
+                        accu += _curMin[i] - distance;
+                        _curMin[i] = distance;
+                    }
+                    maxVal = std::max(maxVal, _curMin[i]);
+                }
+                _nodeMaxCurMin[nodeIdx] = maxVal;
+            } else {
+                accu = addNode(node.left, e) + addNode(node.right, e);
+                _nodeMaxCurMin[nodeIdx] = std::max(_nodeMaxCurMin[node.left], _nodeMaxCurMin[node.right]);
+            }
+            return accu;
+        };
+    };
+}
+
+#endif // EXEMCL_EXEMPLARCLUSTERINGINCREMENTALSTATE_H
@@ -1,27 +1,125 @@
 #ifndef EXEMCL_FUNCTION_CPU
 #define EXEMCL_FUNCTION_CPU
 
+#include <mutex>
+#include <optional>
 #include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/DimensionReduction.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <src/function/cpu/GroundSet.h>
+#include <src/function/cpu/NumaGroundSet.h>
+#include <src/io/FunctionArtifact.h>
+#include <src/io/MappedGroundSet.h>
+#include <tuple>
 #include <utility>
 
 namespace exemcl::cpu {
     /**
-     * This class provides a CPU implementation of the submodular function of exemplar-based clustering.
+     * This class provides a CPU implementation of the submodular function of exemplar-based clustering. The dissimilarity between points is given by a policy (see
+     * `SquaredEuclidean`), which defaults to the squared Euclidean distance. The ground sets, which are created by this class, as well as the scratch buffers of every
+     * evaluation are allocated by an allocation policy (see `DefaultAllocation`), e.g. to back a large V by huge pages.
+     *
+     * Scratch buffers (the prepared copy of the evaluated set, the per-point dissimilarities and the block sums of the reduction) are kept in arenas, which are owned by
+     * the function and handed out to one caller (i.e. thread) at a time. A single idle arena is retained (see `MaxIdleArenas`), whereas the further arenas of concurrent
+     * evaluations (e.g. of batches) are released once their evaluation has finished, hence idle scratch memory never exceeds one evaluation. Once a call of a given
+     * shape has been made, further single evaluations and marginal gains of that shape (and of smaller sets) allocate nothing. This holds for all dissimilarities but the
+     * cosine dissimilarity, whose matrix product allocates, and not for dimensionality reduction. The NUMA mode keeps its per-node buffers in the `NumaGroundSet`.
+     *
+     * The scratch memory of all evaluations of a call can be limited (see `setMemoryLimit`). V is then streamed in tiles, whose per-point dissimilarities fit into the
+     * budget, and batches of sets or marginal elements are evaluated by fewer concurrent workers, hence large calls degrade into chunks rather than running out of memory.
      */
-    template<typename HostDataType = float>
+    template<typename HostDataType = float, typename Dissimilarity = SquaredEuclidean, typename Allocation = DefaultAllocation>
     class ExemplarClusteringSubmodularFunction : public SubmodularFunction {
     public:
         using SubmodularFunction::operator();
 
+        /**
+         * The number of idle arenas (see `ArenaLease`), which are retained for later calls.
+         */
+        static constexpr unsigned long MaxIdleArenas = 1;
+
         /**
          * Constructs the exemplar clustering submodular function using a ground set V.
          *
          * @param V The ground set V.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare V and all evaluated sets.
+         */
+        explicit ExemplarClusteringSubmodularFunction(const MatrixX<HostDataType>& V, int workerCount = -1, const Dissimilarity& dissimilarity = Dissimilarity()) :
+            ExemplarClusteringSubmodularFunction(GroundSet<HostDataType>::template create<Dissimilarity, Allocation>(V, dissimilarity, workerCount), workerCount, dissimilarity) {};
+
+        /**
+         * Constructs the exemplar clustering submodular function using a weighted ground set. L then equals the weighted mean of the minimal dissimilarities, hence
+         * evaluating a ground set, whose duplicates have been collapsed (see `WeightedGroundSet::collapseDuplicates`), yields the same function values as the original
+         * ground set, whereas the cost scales with the number of unique points.
+         *
+         * @param groundSet The weighted ground set.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare V and all evaluated sets.
          */
-        explicit ExemplarClusteringSubmodularFunction(const MatrixX<HostDataType>& V, int workerCount = -1) :
-            SubmodularFunction(workerCount), _V(std::make_unique<MatrixX<HostDataType>>(V)) {
-            MatrixX<HostDataType> zeroVec = VectorX<HostDataType>::Zero(_V->cols()).transpose();
-            _zeroVecValue = L(zeroVec);
+        explicit ExemplarClusteringSubmodularFunction(const WeightedGroundSet<HostDataType>& groundSet, int workerCount = -1,
+                                                      const Dissimilarity& dissimilarity = Dissimilarity()) :
+            ExemplarClusteringSubmodularFunction(GroundSet<HostDataType>::template create<Dissimilarity, Allocation>(groundSet, dissimilarity, workerCount), workerCount,
+                                                 dissimilarity) {};
+
+        /**
+         * Constructs the exemplar clustering submodular function using a memory-mapped ground set (see `MappedGroundSet`). The function is evaluated directly over the
+         * mapping, i.e. V is neither copied nor transformed. Hence, only dissimilarities, which do not need to prepare V, are supported.
+         *
+         * @param groundSet The memory-mapped ground set, which is shared with the caller.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit ExemplarClusteringSubmodularFunction(std::shared_ptr<const MappedGroundSet<HostDataType>> groundSet, int workerCount = -1) :
+            ExemplarClusteringSubmodularFunction(GroundSet<HostDataType>::template fromMapping<Dissimilarity>(std::move(groundSet), workerCount), workerCount) {};
+
+        /**
+         * Constructs the exemplar clustering submodular function using a shared ground set (see `GroundSet`). Neither V nor any of its preprocessed data is copied,
+         * hence any number of functions can share a single ground set.
+         *
+         * @param groundSet The shared ground set, which needs to be prepared by `dissimilarity` (i.e. a policy of the same type and with identical parameters).
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare all evaluated sets.
+         */
+        explicit ExemplarClusteringSubmodularFunction(std::shared_ptr<const GroundSet<HostDataType>> groundSet, int workerCount = -1,
+                                                      const Dissimilarity& dissimilarity = Dissimilarity()) :
+            SubmodularFunction(workerCount),
+            _groundSet(std::move(groundSet)), _dissimilarity(dissimilarity) {
+            if (!_groundSet)
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::ExemplarClusteringSubmodularFunction: The ground set must not be null.");
+            if (_groundSet->getDissimilarity() != Dissimilarity::name)
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::ExemplarClusteringSubmodularFunction: The ground set has been prepared for the dissimilarity '"
+                                         + _groundSet->getDissimilarity() + "', but the function uses '" + Dissimilarity::name + "'.");
+            if (!_groundSet->isPreparedFor(_dissimilarity))
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::ExemplarClusteringSubmodularFunction: The ground set has been prepared with other parameters of "
+                                         "the dissimilarity '" + _groundSet->getDissimilarity() + "' than the ones of the function.");
+        };
+
+        /**
+         * Constructs the exemplar clustering submodular function using a ground set V, which is evaluated in a reduced-dimensional space. V and every set or marginal
+         * element passed to this function are projected by `reduction`, hence the cost of a distance computation drops from \f$d\f$ to \f$k\f$.
+         *
+         * For PCA projections, the residual norms of V are stored alongside the projected data, which allows to bound the error of the function value (see `bounds`). If the
+         * projection has been created in exact-residual mode, the full-dimensional ground set is kept and the projected distances only serve to prune exemplars, which
+         * cannot be closest. For random projections, the function value is bounded by means of the Johnson-Lindenstrauss lemma.
+         *
+         * @param V The ground set V.
+         * @param reduction The projection to apply.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        ExemplarClusteringSubmodularFunction(const MatrixX<HostDataType>& V, const DimensionReduction<HostDataType>& reduction, int workerCount = -1) :
+            SubmodularFunction(workerCount),
+            _groundSet(GroundSet<HostDataType>::template create<SquaredEuclidean, Allocation>(reduction.project(V), SquaredEuclidean(), workerCount)),
+            _reduction(reduction) {
+            static_assert(std::is_same<Dissimilarity, SquaredEuclidean>::value, "Dimensionality reduction requires the squared Euclidean distance.");
+
+            // The zero vector value is computed exactly in the original space.
+            VectorX<HostDataType> squaredNorms = V.rowwise().squaredNorm();
+            _zeroVecValue = reduceSum(squaredNorms.data(), V.rows(), ReductionMode::Compensated) / static_cast<double>(V.rows());
+
+            if (reduction.getMethod() == DimensionReductionMethod::PCA)
+                _residualsV = reduction.residualNorms(V, _groundSet->matrix());
+            if (reduction.isExactResidual())
+                _VFull = std::make_unique<MatrixX<HostDataType>>(V);
         };
 
         /**
@@ -41,53 +139,665 @@ namespace exemcl::cpu {
          * @return The submodular function value.
          */
         double operator()(const MatrixX<double>& S) const override {
-            auto S_copy = std::make_unique<MatrixX<HostDataType>>(S.cast<HostDataType>());
+            ArenaLease arena(*this);
+            arena->tileRows = std::get<2>(calculateProblemDependentChunking(1, S.cols(), S.rows()));
 
-            // Add zero vector to data copy.
-            S_copy->conservativeResize(S_copy->rows() + 1, Eigen::NoChange_t());
-            S_copy->row(S_copy->rows() - 1).setZero();
+            // Prepare a copy of S alongside the zero vector.
+            auto S_inner = arena->exemplars(S, nullptr, _dissimilarity);
 
             // Make calculations.
-            HostDataType L_2 = L(*S_copy);
+            double L_2 = L(S_inner, *arena);
+
+            return zeroVecValue() - L_2;
+        };
+
+        /**
+         * Calculates the marginal gain \f$f(S \cup \{e\}) - f(S)\f$. Both sets are prepared within a single buffer, hence the call does not allocate in steady state.
+         *
+         * @param S The set.
+         * @param elem The marginal element.
+         * @return The marginal gain.
+         */
+        double operator()(const MatrixX<double>& S, VectorXRef<double> elem) const override {
+            if (S.cols() != elem.size())
+                return SubmodularFunction::operator()(S, elem);
+            ArenaLease arena(*this);
+            arena->tileRows = std::get<2>(calculateProblemDependentChunking(1, S.cols(), S.rows() + 1));
+
+            // The buffer holds S, the zero vector and e, hence its leading rows equal S alongside the zero vector.
+            auto S_elem = arena->exemplars(S, &elem, _dissimilarity);
+            double L_elem = L(S_elem, *arena);
+            double L_S = L(S_elem.topRows(S.rows() + 1), *arena);
+
+            return (zeroVecValue() - L_elem) - (zeroVecValue() - L_S);
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function for every set in `S_multi`. The sets are evaluated by as many concurrent workers as the memory limit
+         * permits (see `calculateProblemDependentChunking`), each of which streams V in tiles.
+         *
+         * @param S_multi The sets to evaluate.
+         * @return The submodular function values \f$\left\{f(S_1), ..., f(S_n)\right\}\f$.
+         */
+        std::vector<double> operator()(const std::vector<MatrixX<double>>& S_multi) const override {
+            if (S_multi.empty())
+                return {};
+            return evaluateBatch(
+                S_multi.size(), S_multi[0].cols(), maxRows(S_multi), [&](unsigned long i) -> const MatrixX<double>& { return S_multi[i]; },
+                [](unsigned long) -> const VectorXRef<double>* { return nullptr; },
+                [&](unsigned long, ConstMatrixXRef<HostDataType> S_inner, Arena& arena) { return zeroVecValue() - L(S_inner, arena); });
+        };
+
+        /**
+         * Calculates the marginal gains \f$f(S_i \cup \{e\}) - f(S_i)\f$ for every set in `S_multi`. Neither \f$S_i \cup \{e\}\f$ is copied, nor are all sets held at
+         * once, i.e. the sets are evaluated in chunks, which fit into the memory limit.
+         *
+         * @param S_multi The sets.
+         * @param elem The marginal element.
+         * @return The marginal gains \f$\Delta_f(e | S_1), ..., \Delta_f(e | S_n)\f$.
+         */
+        std::vector<double> operator()(const std::vector<MatrixX<double>>& S_multi, VectorXRef<double> elem) const override {
+            if (S_multi.empty())
+                return {};
+            for (auto& S : S_multi)
+                checkMarginalElement(S, elem);
+            return evaluateBatch(
+                S_multi.size(), S_multi[0].cols(), maxRows(S_multi) + 1, [&](unsigned long i) -> const MatrixX<double>& { return S_multi[i]; },
+                [&](unsigned long) { return &elem; },
+                [&](unsigned long i, ConstMatrixXRef<HostDataType> S_elem, Arena& arena) {
+                    // The leading rows of S_elem equal S_i alongside the zero vector.
+                    double L_elem = L(S_elem, arena);
+                    double L_S = L(S_elem.topRows(S_multi[i].rows() + 1), arena);
+                    return (zeroVecValue() - L_elem) - (zeroVecValue() - L_S);
+                });
+        };
+
+        /**
+         * Calculates the marginal gains \f$f(S \cup \{e_i\}) - f(S)\f$ for every marginal element. \f$f(S)\f$ is evaluated once and the candidates are evaluated in
+         * chunks, which fit into the memory limit, hence the call does not hold a copy of S per candidate.
+         *
+         * @param S The set.
+         * @param elems The marginal elements.
+         * @return The marginal gains \f$\Delta_f(e_1 | S), ..., \Delta_f(e_n | S)\f$.
+         */
+        std::vector<double> operator()(const MatrixX<double>& S, std::vector<VectorXRef<double>> elems) const override {
+            if (elems.empty())
+                return {};
+            for (auto& elem : elems)
+                checkMarginalElement(S, elem);
+            const double S_funcValue = operator()(S);
+            return evaluateBatch(
+                elems.size(), S.cols(), S.rows() + 1, [&](unsigned long) -> const MatrixX<double>& { return S; }, [&](unsigned long i) { return &elems[i]; },
+                [&](unsigned long, ConstMatrixXRef<HostDataType> S_elem, Arena& arena) { return (zeroVecValue() - L(S_elem, arena)) - S_funcValue; });
+        };
+
+        /**
+         * Calculates a lower and an upper bound for the function value of `S`. Without dimensionality reduction (or in exact-residual mode), both bounds equal
+         * \f$f(S)\f$. For PCA projections, the bounds hold deterministically. For random projections, the bounds hold with high probability.
+         *
+         * @param S The set to evaluate.
+         * @return A pair \f$(f_{\text{low}}, f_{\text{high}})\f$ with \f$f_{\text{low}} \leq f(S) \leq f_{\text{high}}\f$.
+         */
+        std::pair<double, double> bounds(const MatrixX<double>& S) const {
+            if (!_reduction || _reduction->isExactResidual()) {
+                double value = operator()(S);
+                return {value, value};
+            }
+
+            ArenaLease arena(*this);
+            arena->tileRows = std::get<2>(calculateProblemDependentChunking(1, S.cols(), S.rows()));
+            auto S_inner = arena->exemplars(S, nullptr, _dissimilarity);
+
+            // Since the zero vector is always part of the evaluated set, L is bounded by [0, L({0})].
+            double lowerL, upperL;
+            if (_reduction->getMethod() == DimensionReductionMethod::PCA) {
+                lowerL = L(S_inner, *arena, DistanceBound::Lower);
+                upperL = L(S_inner, *arena, DistanceBound::Upper);
+            } else {
+                double estimate = L(S_inner, *arena);
+                double epsilon = _reduction->distortion(_groundSet->rows() + S_inner.rows());
+                lowerL = estimate / (1.0 + epsilon);
+                upperL = epsilon < 1.0 ? estimate / (1.0 - epsilon) : zeroVecValue();
+            }
+            lowerL = std::max(lowerL, 0.0);
+            upperL = std::min(upperL, zeroVecValue());
+
+            return {zeroVecValue() - upperL, zeroVecValue() - lowerL};
+        };
+
+        /**
+         * Saves the preprocessed state of this function (the prepared ground set, its weights, the parameters of the dissimilarity, the dimensionality reduction and
+         * the residual norms as well as \f$L(\{0\})\f$) as a versioned artifact (see `FunctionArtifactHeader`), which can be restored by `load` without any further preprocessing.
+         *
+         * @param path Path of the artifact. An existing file is replaced atomically.
+         */
+        void save(const std::string& path) const {
+            auto V = _groundSet->matrix();
+            const VectorX<HostDataType>& weights = _groundSet->getWeights();
+
+            FunctionArtifactHeader header = FunctionArtifactHeader::create(sizeof(HostDataType), Dissimilarity::name);
+            header.zeroVecValue = zeroVecValue();
+            header.totalWeight = _groundSet->getTotalWeight();
+            if (weights.size() > 0)
+                header.flags |= FunctionArtifactHeader::Weighted;
+            if (_reduction) {
+                header.flags |= FunctionArtifactHeader::Reduced | (_reduction->isExactResidual() ? FunctionArtifactHeader::ExactResidual : 0);
+                header.reductionMethod = static_cast<uint32_t>(_reduction->getMethod());
+            }
+
+            const MatrixX<HostDataType> noProjection;
+            const VectorX<HostDataType> noMean;
+            const MatrixX<HostDataType>& P = _reduction ? _reduction->getProjection() : noProjection;
+            const VectorX<HostDataType>& mean = _reduction ? _reduction->getMean() : noMean;
+            const VectorX<double> parameters = _dissimilarity.parameters();
+            writeFunctionArtifact(path, header,
+                                  {{weights.data(), weights.size(), 1},
+                                   {P.data(), P.rows(), P.cols()},
+                                   {mean.data(), mean.size(), 1},
+                                   {_residualsV.data(), _residualsV.size(), 1},
+                                   {_VFull ? _VFull->data() : nullptr, _VFull ? _VFull->rows() : 0, _VFull ? _VFull->cols() : 0},
+                                   {parameters.data(), parameters.size(), 1},
+                                   {V.data(), V.rows(), V.cols()}});
+        };
+
+        /**
+         * Restores a function from an artifact, which has been written by `save`. Unless a dimensionality reduction is used, the prepared ground set is mapped (see
+         * `MappedGroundSet`) rather than read, hence loading does not depend on the size of the ground set and all processes on a host share a single copy of it.
+         *
+         * The artifact needs to match the format version, the byte order, the scalar type and the dissimilarity of the running build. The dissimilarity policy is restored
+         * from the parameters in the artifact (see `SquaredEuclidean::fromParameters`), since it prepares every evaluated set.
+         *
+         * @param path Path of the artifact.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy of the saved function (optional). If given, its parameters need to match the ones in the artifact.
+         * @return The restored function.
+         */
+        static std::unique_ptr<ExemplarClusteringSubmodularFunction> load(const std::string& path, int workerCount = -1,
+                                                                          const std::optional<Dissimilarity>& dissimilarity = std::nullopt) {
+            FunctionArtifactHeader header = readFunctionArtifactHeader(path);
+            if (header.scalarSize != sizeof(HostDataType))
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::load: '" + path + "' holds scalars of " + std::to_string(header.scalarSize)
+                                         + " byte, but the function uses scalars of " + std::to_string(sizeof(HostDataType)) + " byte.");
+            if (std::string(header.dissimilarity) != Dissimilarity::name)
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::load: '" + path + "' has been saved for the dissimilarity '" + header.dissimilarity
+                                         + "', but the function uses '" + Dissimilarity::name + "'.");
+            if (!header.has(ArtifactSection::GroundSet))
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::load: '" + path + "' does not hold a ground set.");
+
+            auto readVector = [&](ArtifactSection id) {
+                return header.has(id) ? VectorX<HostDataType>(readFunctionArtifactSection<HostDataType>(path, header, id).col(0)) : VectorX<HostDataType>();
+            };
+
+            // The policy of the saved function has prepared the ground set, hence the caller may only confirm its parameters.
+            VectorX<double> parameters;
+            if (header.has(ArtifactSection::DissimilarityParameters))
+                parameters = readFunctionArtifactSection<double>(path, header, ArtifactSection::DissimilarityParameters).col(0);
+            if (dissimilarity && !equalDissimilarityParameters(dissimilarity->parameters(), parameters))
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::load: The parameters of the dissimilarity '" + std::string(Dissimilarity::name)
+                                         + "' do not match the ones, which have been saved in '" + path + "'.");
+            const Dissimilarity savedDissimilarity = Dissimilarity::fromParameters(parameters);
+
+            // The reduced evaluation holds the projected ground set in memory, whose L({0}) differs from the one of the function.
+            const bool reduced = header.flags & FunctionArtifactHeader::Reduced;
+            const uint64_t* section = header.section(ArtifactSection::GroundSet);
+            std::shared_ptr<const GroundSet<HostDataType>> groundSet;
+            if (reduced)
+                groundSet = GroundSet<HostDataType>::template create<SquaredEuclidean, Allocation>(
+                    readFunctionArtifactSection<HostDataType>(path, header, ArtifactSection::GroundSet), SquaredEuclidean(), workerCount);
+            else {
+                auto mapping = MappedGroundSet<HostDataType>::fromRaw(path, section[2], section[0]);
+                if (mapping->rows() != section[1])
+                    throw std::runtime_error("ExemplarClusteringSubmodularFunction::load: The ground set of '" + path + "' is not stored at the end of the file.");
+                groundSet = GroundSet<HostDataType>::restore(MatrixX<HostDataType>(), std::move(mapping), readVector(ArtifactSection::Weights), header.totalWeight,
+                                                             header.zeroVecValue, header.dissimilarity, parameters);
+            }
+
+            std::unique_ptr<ExemplarClusteringSubmodularFunction> function(new ExemplarClusteringSubmodularFunction(groundSet, workerCount, savedDissimilarity));
+            function->_zeroVecValue = header.zeroVecValue;
+            if (reduced) {
+                function->_reduction = DimensionReduction<HostDataType>::restore(
+                    static_cast<DimensionReductionMethod>(header.reductionMethod), header.flags & FunctionArtifactHeader::ExactResidual,
+                    readFunctionArtifactSection<HostDataType>(path, header, ArtifactSection::Projection),
+                    readVector(ArtifactSection::Mean));
+                function->_residualsV = readVector(ArtifactSection::Residuals);
+                if (header.has(ArtifactSection::FullGroundSet))
+                    function->_VFull =
+                        std::make_unique<MatrixX<HostDataType>>(readFunctionArtifactSection<HostDataType>(path, header, ArtifactSection::FullGroundSet));
+            }
+            return function;
+        };
+
+        /**
+         * Enables or disables the NUMA mode. In NUMA mode, V is copied into one shard per node of `topology` (see `NumaGroundSet`), which is allocated in the memory of its
+         * node and evaluated by threads pinned to it. The per-node partial sums are merged afterwards, hence the function values equal the ones of the default mode (in
+         * compensated or deterministic mode, they are bit-identical). The shards are held in addition to the shared ground set.
+         *
+         * Batches of sets or marginal elements are evaluated one after another in NUMA mode, such that every evaluation employs the pinned threads of all nodes.
+         *
+         * @param enabled True, if the NUMA mode is to be used.
+         * @param placement Selects, how the shards are placed onto their nodes.
+         * @param topology The nodes, which receive a shard.
+         */
+        void setNumaMode(bool enabled, NumaPlacement placement, const NumaTopology& topology) {
+            if (enabled && _reduction)
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::setNumaMode: The NUMA mode does not support dimensionality reduction.");
+            _numaGroundSet.reset();
+            if (enabled)
+                _numaGroundSet = std::make_unique<NumaGroundSet<HostDataType>>(*_groundSet, topology, placement, _workerCount);
+        };
+
+        /**
+         * Enables or disables the NUMA mode with a shard per node of the host (see above). The topology is only detected, if the NUMA mode is enabled.
+         *
+         * @param enabled True, if the NUMA mode is to be used.
+         * @param placement Selects, how the shards are placed onto their nodes.
+         */
+        void setNumaMode(bool enabled, NumaPlacement placement = NumaPlacement::FirstTouch) {
+            if (enabled)
+                setNumaMode(true, placement, NumaTopology::detect());
+            else
+                _numaGroundSet.reset();
+        };
+
+        /**
+         * Returns true, if the NUMA mode is enabled.
+         * @return As stated above.
+         */
+        bool isNumaMode() const {
+            return _numaGroundSet != nullptr;
+        };
+
+        /**
+         * Limits the scratch memory, which is used by the evaluations of a single call (i.e. the prepared copies of the evaluated sets, the per-point dissimilarities and
+         * the block sums of the reduction). The ground set is shared (and possibly mapped), hence it does not count towards the limit. Neither do the temporaries of
+         * the cosine dissimilarity, of dimensionality reduction and of the NUMA mode, which evaluates V without tiles.
+         *
+         * @param memoryLimit Memory limit (in byte), or -1, if the memory is not to be limited.
+         */
+        void setMemoryLimit(long memoryLimit) override {
+            if (memoryLimit >= 0) {
+                const std::size_t minimum = evaluationBytes(1, _groundSet->cols(), std::min<unsigned long>(_groundSet->rows(), ReductionBlockSize));
+                if (static_cast<std::size_t>(memoryLimit) < minimum)
+                    throw std::runtime_error("ExemplarClusteringSubmodularFunction::setMemoryLimit: Inadequate memory limit set. At least " + std::to_string(minimum)
+                                             + " byte are required to evaluate the function. Please set a higher memory limit.");
+            }
+            _memoryLimit = memoryLimit >= 0 ? memoryLimit : -1;
+
+            // Release the buffers, which have been sized for the previous limit. Arenas, which are currently leased, are released on return.
+            std::lock_guard<std::mutex> lock(_arenaMutex);
+            _arenaGeneration++;
+            _arenas.clear();
+        };
+
+        /**
+         * Returns the number of idle arenas, i.e. of scratch buffers, which are retained for later calls (at most `MaxIdleArenas`).
+         * @return As stated above.
+         */
+        unsigned long getIdleArenaCount() const {
+            std::lock_guard<std::mutex> lock(_arenaMutex);
+            return _arenas.size();
+        };
+
+        /**
+         * Returns the memory limit (in byte), or -1, if the memory is not limited.
+         * @return As stated above.
+         */
+        long getMemoryLimit() const {
+            return _memoryLimit;
+        };
+
+        /**
+         * This function calculates how a given problem should be chunked in order to solve it within the memory limit. Every concurrent evaluation holds a copy of its
+         * set, the block sums of V and the dissimilarities of a tile of V. If the limit does not suffice for one evaluation per worker and set, the number of concurrent
+         * evaluations is reduced, until tiles of (at least) `ReductionBlockSize` points fit. Tiles are multiples of `ReductionBlockSize`, hence the compensated and the
+         * deterministic reduction yield the same result as an evaluation without tiles.
+         *
+         * @param setCount The number of sets to evaluate.
+         * @param dim The dimensionality of every data point.
+         * @param maxS The cardinality of the greatest set to evaluate.
+         * @return A three-valued tuple consisting of total memory requirements for this problem without chunking (in bytes), the number of sets to evaluate concurrently
+         * and the number of points of V per tile.
+         */
+        std::tuple<std::size_t, unsigned long, unsigned long> calculateProblemDependentChunking(unsigned long setCount, unsigned long dim, unsigned long maxS) const {
+            const unsigned long n = _groundSet->rows();
+            const unsigned long concurrency = std::max<unsigned long>(1, std::min<unsigned long>(_workerCount, setCount));
+            const std::size_t memoryRequirements = concurrency * evaluationBytes(maxS, dim, n);
+            if (_memoryLimit < 0 || memoryRequirements <= static_cast<std::size_t>(_memoryLimit))
+                return std::make_tuple(memoryRequirements, concurrency, n);
+
+            // Run as many evaluations concurrently as fit with the smallest tile.
+            const unsigned long minTileRows = std::min<unsigned long>(n, ReductionBlockSize);
+            const unsigned long chunkSize = std::min<unsigned long>(concurrency, _memoryLimit / evaluationBytes(maxS, dim, minTileRows));
+            if (chunkSize == 0)
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::calculateProblemDependentChunking: No memory left to evaluate the function.");
+
+            // Spend the remaining share of every evaluation on its tile.
+            const std::size_t share = _memoryLimit / chunkSize - evaluationBytes(maxS, dim, 0);
+            const unsigned long tileRows = share / sizeof(HostDataType) / ReductionBlockSize * ReductionBlockSize;
+
+            return std::make_tuple(memoryRequirements, chunkSize, std::max(minTileRows, std::min(n, tileRows)));
+        };
+
+        /**
+         * Returns a read-only view of the (prepared and possibly projected) ground set V, which does not copy V.
+         * @return As stated above.
+         */
+        Eigen::Map<const MatrixX<HostDataType>> getV() const {
+            return _groundSet->matrix();
+        };
 
-            return _zeroVecValue - L_2;
+        /**
+         * Returns the per-point weights of the ground set, or an empty vector, if the ground set is unweighted.
+         * @return As stated above.
+         */
+        const VectorX<HostDataType>& getWeights() const {
+            return _groundSet->getWeights();
         };
 
         /**
-         * Returns a reference to the ground set V.
+         * Returns the shared ground set, e.g. to construct further functions without copying V.
          * @return As stated above.
          */
-        const MatrixX<HostDataType>& getV() const {
-            return _V;
+        const std::shared_ptr<const GroundSet<HostDataType>>& getGroundSet() const {
+            return _groundSet;
         };
 
     private:
-        HostDataType _zeroVecValue;
-        const std::unique_ptr<MatrixX<HostDataType>> _V;
+        /**
+         * Selects, which pairwise distance is used for points in the reduced space.
+         */
+        enum class DistanceBound { Estimate, Lower, Upper };
+
+        /**
+         * The scratch buffers of a single evaluation, which only grow.
+         */
+        struct Arena {
+            MatrixX<HostDataType> exemplarBuffer;
+            std::shared_ptr<HostDataType> distances;
+            std::size_t distanceCapacity = 0;
+            std::vector<double> blockSums;
+            unsigned long tileRows = 0;   // The number of points of V, whose dissimilarities are held at once (0 = all).
+            unsigned long generation = 0; // The memory limit, for which the buffers have been sized (see `_arenaGeneration`).
+
+            /**
+             * Copies S, the zero vector and (optionally) a marginal element into the leading rows of the exemplar buffer and prepares them.
+             */
+            typename MatrixX<HostDataType>::RowsBlockXpr exemplars(const MatrixX<double>& S, const VectorXRef<double>* elem, const Dissimilarity& dissimilarity) {
+                const Eigen::Index rows = S.rows() + (elem != nullptr ? 2 : 1);
+                if (exemplarBuffer.rows() < rows || exemplarBuffer.cols() != S.cols())
+                    exemplarBuffer.resize(std::max(rows, 2 * exemplarBuffer.rows()), S.cols());
+
+                auto points = exemplarBuffer.topRows(S.rows());
+                points = S.cast<HostDataType>();
+                dissimilarity.prepare(points);
+                exemplarBuffer.row(S.rows()).setZero();
+                if (elem != nullptr) {
+                    auto marginal = exemplarBuffer.row(S.rows() + 1);
+                    marginal = elem->transpose().template cast<HostDataType>();
+                    dissimilarity.prepare(marginal);
+                }
+                return exemplarBuffer.topRows(rows);
+            };
+
+            /**
+             * Returns a buffer for (at least) `n` per-point dissimilarities.
+             */
+            HostDataType* distanceBuffer(std::size_t n) {
+                if (distanceCapacity < n) {
+                    distances = allocateShared<HostDataType, Allocation>(n);
+                    distanceCapacity = n;
+                }
+                return distances.get();
+            };
+        };
+
+        /**
+         * Hands out an arena to a single caller and returns it to the function on destruction.
+         */
+        class ArenaLease {
+        public:
+            explicit ArenaLease(const ExemplarClusteringSubmodularFunction& function) : _function(function) {
+                std::lock_guard<std::mutex> lock(_function._arenaMutex);
+                if (_function._arenas.empty())
+                    _arena = std::make_unique<Arena>();
+                else {
+                    _arena = std::move(_function._arenas.back());
+                    _function._arenas.pop_back();
+                }
+                _arena->generation = _function._arenaGeneration;
+            };
+
+            ArenaLease(const ArenaLease&) = delete;
+            ArenaLease& operator=(const ArenaLease&) = delete;
+
+            ~ArenaLease() {
+                // Further arenas and arenas, which have been sized for a previous memory limit, are released once the lease (i.e. `_arena`) is destroyed, hence
+                // outside of the lock.
+                std::lock_guard<std::mutex> lock(_function._arenaMutex);
+                if (_function._arenas.size() < MaxIdleArenas && _arena->generation == _function._arenaGeneration)
+                    _function._arenas.push_back(std::move(_arena));
+            };
+
+            Arena* operator->() const {
+                return _arena.get();
+            };
+
+            Arena& operator*() const {
+                return *_arena;
+            };
+
+        private:
+            const ExemplarClusteringSubmodularFunction& _function;
+            std::unique_ptr<Arena> _arena;
+        };
+
+        std::optional<double> _zeroVecValue; // L({0}), if it differs from the one of the ground set (see `zeroVecValue`).
+        const std::shared_ptr<const GroundSet<HostDataType>> _groundSet;
+        Dissimilarity _dissimilarity;
+
+        // Dimensionality reduction (optional).
+        std::optional<DimensionReduction<HostDataType>> _reduction;
+        VectorX<HostDataType> _residualsV;
+        std::unique_ptr<MatrixX<HostDataType>> _VFull;
+
+        // Per-node shards of V (optional, see `setNumaMode`).
+        std::unique_ptr<NumaGroundSet<HostDataType>> _numaGroundSet;
+
+        // Arenas, which are currently not handed out (see `ArenaLease`).
+        mutable std::mutex _arenaMutex;
+        mutable std::vector<std::unique_ptr<Arena>> _arenas;
+        unsigned long _arenaGeneration = 0; // Incremented with every change of the memory limit.
+
+        // Scratch memory of a single call (-1 = no limit, see `setMemoryLimit`).
+        long _memoryLimit = -1;
+
+        /**
+         * Returns the number of bytes, which a single evaluation of a set with `maxS` points (alongside the zero vector and a marginal element) occupies with tiles of
+         * `tileRows` points. The exemplar buffer of an arena grows geometrically, hence up to twice the rows are accounted for.
+         */
+        std::size_t evaluationBytes(unsigned long maxS, unsigned long dim, unsigned long tileRows) const {
+            const std::size_t setBytes = 2 * (maxS + 2) * dim * sizeof(HostDataType);
+            const std::size_t blockSumBytes = (_groundSet->rows() + ReductionBlockSize - 1) / ReductionBlockSize * sizeof(double);
+            return setBytes + blockSumBytes + tileRows * sizeof(HostDataType);
+        };
+
+        /**
+         * Returns the number of sets of a batch, which are evaluated concurrently. In NUMA mode, the sets are evaluated one after another, since every evaluation runs
+         * one pinned team per node (which would degrade to a single, unpinned thread within a parallel region).
+         */
+        unsigned long concurrentEvaluations(const std::tuple<std::size_t, unsigned long, unsigned long>& chunking) const {
+            return _numaGroundSet ? 1 : std::get<1>(chunking);
+        };
+
+        /**
+         * Returns \f$L(\{0\})\f$ of the evaluated ground set. Unless it has been computed in the original space (see `DimensionReduction`), it is provided by the ground
+         * set, which computes it on first use, if the ground set is memory-mapped.
+         */
+        double zeroVecValue() const {
+            return _zeroVecValue ? *_zeroVecValue : _groundSet->getZeroVecValue();
+        };
+
+        /**
+         * Evaluates a batch of `count` sets as concurrently as the memory limit permits (see `calculateProblemDependentChunking`). Every evaluation leases an arena,
+         * prepares `setOf(i)` alongside the zero vector and the (optional) marginal element `elemOf(i)` within it and yields `evaluate(i, exemplars, arena)`.
+         *
+         * @param count The number of sets.
+         * @param dim The dimensionality of the sets.
+         * @param maxS The greatest number of rows per evaluation (excluding the zero vector).
+         * @param setOf Returns the `i`-th set.
+         * @param elemOf Returns a pointer to the `i`-th marginal element (or null).
+         * @param evaluate Evaluates the prepared exemplars of the `i`-th set.
+         * @return The results of all evaluations.
+         */
+        template<typename SetOf, typename ElemOf, typename Evaluate>
+        std::vector<double> evaluateBatch(unsigned long count, unsigned long dim, unsigned long maxS, SetOf&& setOf, ElemOf&& elemOf, Evaluate&& evaluate) const {
+            std::vector<double> results(count);
+            auto chunking = calculateProblemDependentChunking(count, dim, maxS);
+
+#pragma omp parallel for num_threads(concurrentEvaluations(chunking)) schedule(dynamic)
+            for (unsigned long i = 0; i < count; i++) {
+                ArenaLease arena(*this);
+                arena->tileRows = std::get<2>(chunking);
+                auto exemplars = arena->exemplars(setOf(i), elemOf(i), _dissimilarity);
+                results[i] = evaluate(i, exemplars, *arena);
+            }
+
+            return results;
+        };
+
+        /**
+         * Returns the greatest cardinality of the sets.
+         */
+        static unsigned long maxRows(const std::vector<MatrixX<double>>& S_multi) {
+            unsigned long maxS = 0;
+            for (auto& S : S_multi)
+                maxS = std::max<unsigned long>(maxS, S.rows());
+            return maxS;
+        };
+
+        /**
+         * Throws, if the dimensionality of a marginal element does not match the one of S.
+         */
+        static void checkMarginalElement(const MatrixX<double>& S, const VectorXRef<double>& elem) {
+            if (S.cols() != elem.size())
+                throw std::runtime_error("ExemplarClusteringSubmodularFunction::operator(): The number of columns in matrix `S` and the number of elements in vector `elem` do "
+                                         "not match ("
+                                         + std::to_string(S.cols()) + " vs. " + std::to_string(elem.size()) + ").");
+        };
+
+        /**
+         * Sums up the (weighted) dissimilarities of all points of V, which are computed tile by tile. `fill(begin, length, distances)` writes the dissimilarities of the
+         * points `begin`, ..., `begin + length - 1` into `distances`.
+         *
+         * @param arena The scratch buffers of the evaluation, which determine the tile size.
+         * @param fill Computes the dissimilarities of a tile.
+         * @return The sum.
+         */
+        template<typename Fill>
+        double sumTiles(Arena& arena, Fill&& fill) const {
+            const unsigned long n = _groundSet->rows();
+            const unsigned long tileRows = arena.tileRows > 0 ? std::min(arena.tileRows, n) : n;
+            HostDataType* accuArray = arena.distanceBuffer(tileRows);
+            if (tileRows == n) {
+                fill(0ul, n, accuArray);
+                return reduceSum(accuArray, n, _reductionMode, _workerCount, _deterministic, arena.blockSums);
+            }
+
+            // Tiles start at multiples of the block size, hence the blocks equal the ones of `reduceSum`.
+            const bool blocked = _reductionMode == ReductionMode::Compensated || _deterministic;
+            arena.blockSums.resize(blocked ? (n + ReductionBlockSize - 1) / ReductionBlockSize : 0);
+            double accu = 0.0;
+            for (unsigned long begin = 0; begin < n; begin += tileRows) {
+                const unsigned long length = std::min(tileRows, n - begin);
+                fill(begin, length, accuArray);
+                if (blocked) {
+                    const unsigned long blockCount = (length + ReductionBlockSize - 1) / ReductionBlockSize;
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+                    for (unsigned long b = 0; b < blockCount; b++)
+                        arena.blockSums[begin / ReductionBlockSize + b] =
+                            blockSum(accuArray + b * ReductionBlockSize, std::min(ReductionBlockSize, length - b * ReductionBlockSize), _reductionMode);
+                } else
+                    accu += reduceSum(accuArray, length, _reductionMode, _workerCount);
+            }
+
+            return blocked ? pairwiseSum(arena.blockSums.data(), arena.blockSums.size()) : accu;
+        };
 
         /**
          * Calculates the L function.
          *
          * @param S_inner Set of data to calculate the L function for.
+         * @param arena The scratch buffers of the evaluation.
+         * @param bound Selects estimated, lower-bounded or upper-bounded distances, if dimensionality reduction is used.
          * @return L function value.
          */
-        HostDataType L(const MatrixX<HostDataType>& S_inner) const {
-            auto* accuArray = new HostDataType[_V->rows()];
+        double L(ConstMatrixXRef<HostDataType> S_inner, Arena& arena, DistanceBound bound = DistanceBound::Estimate) const {
+            if (_reduction)
+                return LReduced(S_inner, arena, bound);
 
-            for (unsigned int i = 0; i < _V->rows(); i++) {
-                auto min_val = std::numeric_limits<HostDataType>::max();
-                for (unsigned int j = 0; j < S_inner.rows(); j++)
-                    min_val = std::min((_V->row(i) - S_inner.row(j)).squaredNorm(), min_val);
-                accuArray[i] = min_val;
-            }
+            auto V = _groundSet->matrix();
+            const VectorX<HostDataType>& weights = _groundSet->getWeights();
+            const double normalizer = weights.size() > 0 ? _groundSet->getTotalWeight() : static_cast<double>(V.rows());
+            if (_numaGroundSet)
+                return _numaGroundSet->template sumMinDissimilarities<Dissimilarity>(S_inner, _reductionMode, _workerCount, _deterministic) / normalizer;
+
+            auto fill = [&](unsigned long begin, unsigned long length, HostDataType* accuArray) {
+                kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(V.middleRows(begin, length), S_inner, accuArray, _workerCount);
+
+                // Weigh the minimal dissimilarities, if necessary.
+                if (weights.size() > 0) {
+                    Eigen::Map<VectorX<HostDataType>> minDistances(accuArray, length);
+                    minDistances.array() *= weights.segment(begin, length).array();
+                }
+            };
+
+            return sumTiles(arena, fill) / normalizer;
+        };
+
+        /**
+         * Calculates the L function in the reduced space.
+         *
+         * @param S_inner Set of data (in the original space) to calculate the L function for.
+         * @param arena The scratch buffers of the evaluation.
+         * @param bound Selects estimated, lower-bounded or upper-bounded distances.
+         * @return L function value.
+         */
+        double LReduced(ConstMatrixXRef<HostDataType> S_inner, Arena& arena, DistanceBound bound) const {
+            MatrixX<HostDataType> S_projected = _reduction->project(S_inner);
+            bool pca = _reduction->getMethod() == DimensionReductionMethod::PCA;
+            bool exact = _reduction->isExactResidual();
+            VectorX<HostDataType> residualsS = pca ? _reduction->residualNorms(S_inner, S_projected) : VectorX<HostDataType>();
 
-            HostDataType accu = 0.0;
-#pragma omp simd reduction(+ : accu)
-            for (unsigned int i = 0; i < _V->rows(); i++)
-                accu += accuArray[i];
+            auto V = _groundSet->matrix();
+            auto fill = [&](unsigned long begin, unsigned long length, HostDataType* accuArray) {
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+                for (unsigned long i = begin; i < begin + length; i++) {
+                    auto min_val = std::numeric_limits<HostDataType>::max();
+                    for (unsigned int j = 0; j < S_inner.rows(); j++) {
+                        HostDataType distance = (V.row(i) - S_projected.row(j)).squaredNorm();
+                        if (pca) {
+                            HostDataType rDiff = _residualsV[i] - residualsS[j];
+                            HostDataType rSum = _residualsV[i] + residualsS[j];
+                            if (exact) {
+                                // The lower bound prunes exemplars, which cannot be closer than the current minimum.
+                                if (distance + rDiff * rDiff < min_val)
+                                    distance = (_VFull->row(i) - S_inner.row(j)).squaredNorm();
+                                else
+                                    continue;
+                            } else if (bound == DistanceBound::Lower)
+                                distance += rDiff * rDiff;
+                            else if (bound == DistanceBound::Upper)
+                                distance += rSum * rSum;
+                            else
+                                distance += _residualsV[i] * _residualsV[i] + residualsS[j] * residualsS[j];
+                        }
+                        min_val = std::min(distance, min_val);
+                    }
+                    accuArray[i - begin] = min_val;
+                }
+            };
 
-            delete[] accuArray;
-            return accu / static_cast<HostDataType>(_V->rows());
+            return sumTiles(arena, fill) / static_cast<double>(V.rows());
         };
     };
 }
@@ -0,0 +1,316 @@
+#ifndef EXEMCL_FUNCTION_CPU_GROUNDSET
+#define EXEMCL_FUNCTION_CPU_GROUNDSET
+
+#include <memory>
+#include <mutex>
+#include <src/function/Dissimilarity.h>
+#include <src/function/Reduction.h>
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/AllocationPolicy.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <src/function/cpu/WeightedGroundSet.h>
+#include <src/io/MappedGroundSet.h>
+#include <string>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * An immutable, prepared ground set, which is shared by reference counting (`std::shared_ptr<const GroundSet>`) between any number of function instances (and Python
+     * handles), such that V is held only once per process.
+     *
+     * A ground set is prepared for a single dissimilarity policy instance, i.e. V is transformed by its `prepare` exactly once on creation. Hence, the ground set records
+     * both the name and the parameters of the policy (see `SquaredEuclidean::parameters`). Alongside V, the ground set holds the optional per-point weights and
+     * \f$L(\{0\})\f$, hence constructing a function from it is free of any pass over V. The points are either owned or backed by a memory mapping (see
+     * `MappedGroundSet`). Owned points are allocated by an allocation policy (see `DefaultAllocation`).
+     */
+    template<typename HostDataType = float>
+    class GroundSet {
+    public:
+        /**
+         * Creates a ground set from a copy of V. Unless the default allocation policy is used, V is copied straight into memory of the given policy and prepared in
+         * place, i.e. the ground set does not hold a second copy of V at any time.
+         *
+         * @param V The ground set V.
+         * @param dissimilarity The dissimilarity policy, which prepares V.
+         * @param workerCount The number of workers to employ for the preprocessing (defaults to -1, i.e. all available cores).
+         * @return The shared ground set.
+         */
+        template<typename Dissimilarity = SquaredEuclidean, typename Allocation = DefaultAllocation>
+        static std::shared_ptr<const GroundSet> create(const MatrixX<HostDataType>& V, const Dissimilarity& dissimilarity = Dissimilarity(), int workerCount = -1) {
+            return build<Dissimilarity, Allocation>(V, VectorX<HostDataType>(), 0.0, dissimilarity, workerCount);
+        };
+
+        /**
+         * Creates a ground set from V, which is moved in. With the default allocation policy, V is prepared in place and adopted without any copy.
+         *
+         * @param V The ground set V.
+         * @param dissimilarity The dissimilarity policy, which prepares V.
+         * @param workerCount The number of workers to employ for the preprocessing (defaults to -1, i.e. all available cores).
+         * @return The shared ground set.
+         */
+        template<typename Dissimilarity = SquaredEuclidean, typename Allocation = DefaultAllocation>
+        static std::shared_ptr<const GroundSet> create(MatrixX<HostDataType>&& V, const Dissimilarity& dissimilarity = Dissimilarity(), int workerCount = -1) {
+            return build<Dissimilarity, Allocation>(std::move(V), VectorX<HostDataType>(), 0.0, dissimilarity, workerCount);
+        };
+
+        /**
+         * Creates a weighted ground set (see `WeightedGroundSet`).
+         *
+         * @param weightedGroundSet The points alongside their weights.
+         * @param dissimilarity The dissimilarity policy, which prepares the points.
+         * @param workerCount The number of workers to employ for the preprocessing (defaults to -1, i.e. all available cores).
+         * @return The shared ground set.
+         */
+        template<typename Dissimilarity = SquaredEuclidean, typename Allocation = DefaultAllocation>
+        static std::shared_ptr<const GroundSet> create(const WeightedGroundSet<HostDataType>& weightedGroundSet, const Dissimilarity& dissimilarity = Dissimilarity(),
+                                                       int workerCount = -1) {
+            return build<Dissimilarity, Allocation>(weightedGroundSet.points, weightedGroundSet.weights.template cast<HostDataType>(), weightedGroundSet.weights.sum(),
+                                                    dissimilarity, workerCount);
+        };
+
+        /**
+         * Creates a ground set, which is evaluated directly over a memory mapping. Since the mapping is read-only, only dissimilarities, which do not need to prepare V,
+         * are supported. The mapping is not read on construction, \f$L(\{0\})\f$ is computed on first use instead (see `getZeroVecValue`).
+         *
+         * @param mapping The memory-mapped ground set.
+         * @param workerCount The number of workers to employ for the preprocessing (defaults to -1, i.e. all available cores).
+         * @return The shared ground set.
+         */
+        template<typename Dissimilarity = SquaredEuclidean>
+        static std::shared_ptr<const GroundSet> fromMapping(std::shared_ptr<const MappedGroundSet<HostDataType>> mapping, int workerCount = -1) {
+            static_assert(std::is_same<Dissimilarity, SquaredEuclidean>::value || std::is_same<Dissimilarity, Manhattan>::value,
+                          "Memory-mapped ground sets require a dissimilarity, which does not transform the ground set.");
+            if (!mapping)
+                throw std::runtime_error("GroundSet::fromMapping: The mapped ground set must not be null.");
+            std::shared_ptr<GroundSet> groundSet(
+                new GroundSet(MatrixX<HostDataType>(), std::move(mapping), VectorX<HostDataType>(), 0.0, Dissimilarity::name, VectorX<double>(), workerCount));
+            groundSet->_zeroValueOf = &GroundSet::zeroValue<Dissimilarity>;
+            return groundSet;
+        };
+
+        /**
+         * Restores a ground set, whose points have already been prepared and whose \f$L(\{0\})\f$ is known (e.g. from a saved artifact). Either `points` or `mapping`
+         * provides the points.
+         *
+         * @param points The prepared points (ignored, if `mapping` is given).
+         * @param mapping The memory-mapped, prepared points (optional).
+         * @param weights The per-point weights (or an empty vector).
+         * @param totalWeight The sum of the weights.
+         * @param zeroVecValue The value of \f$L(\{0\})\f$.
+         * @param dissimilarity The name of the dissimilarity, which has prepared the points.
+         * @param dissimilarityParameters The parameters of the dissimilarity, which has prepared the points.
+         * @return The shared ground set.
+         */
+        static std::shared_ptr<const GroundSet> restore(MatrixX<HostDataType> points, std::shared_ptr<const MappedGroundSet<HostDataType>> mapping,
+                                                        VectorX<HostDataType> weights, double totalWeight, double zeroVecValue, const std::string& dissimilarity,
+                                                        VectorX<double> dissimilarityParameters) {
+            std::shared_ptr<GroundSet> groundSet(
+                new GroundSet(std::move(points), std::move(mapping), std::move(weights), totalWeight, dissimilarity, std::move(dissimilarityParameters), -1));
+            groundSet->checkWeights();
+            groundSet->_zeroVecValue = zeroVecValue;
+            return groundSet;
+        };
+
+        GroundSet(const GroundSet&) = delete;
+        GroundSet& operator=(const GroundSet&) = delete;
+
+        /**
+         * Returns a read-only view of the prepared points (without any copy).
+         * @return As stated above.
+         */
+        Eigen::Map<const MatrixX<HostDataType>> matrix() const {
+            if (_mapping)
+                return _mapping->matrix();
+            if (_storage)
+                return Eigen::Map<const MatrixX<HostDataType>>(_storage.get(), _storageRows, _storageCols);
+            return Eigen::Map<const MatrixX<HostDataType>>(_points.data(), _points.rows(), _points.cols());
+        };
+
+        /**
+         * Returns the number of points.
+         * @return As stated above.
+         */
+        unsigned long rows() const {
+            return _mapping ? _mapping->rows() : _storage ? _storageRows : _points.rows();
+        };
+
+        /**
+         * Returns the dimensionality of the points.
+         * @return As stated above.
+         */
+        unsigned long cols() const {
+            return _mapping ? _mapping->cols() : _storage ? _storageCols : _points.cols();
+        };
+
+        /**
+         * Returns the per-point weights, or an empty vector, if the ground set is unweighted.
+         * @return As stated above.
+         */
+        const VectorX<HostDataType>& getWeights() const {
+            return _weights;
+        };
+
+        /**
+         * Returns the sum of the weights (or zero, if the ground set is unweighted).
+         * @return As stated above.
+         */
+        double getTotalWeight() const {
+            return _totalWeight;
+        };
+
+        /**
+         * Returns the (weighted) mean dissimilarity of the points to the zero vector, i.e. \f$L(\{0\})\f$. Memory-mapped ground sets (see `fromMapping`) compute it once, on
+         * the first call, by a single pass over the mapping.
+         * @return As stated above.
+         */
+        double getZeroVecValue() const {
+            if (_zeroValueOf)
+                std::call_once(_zeroVecOnce, [this]() { _zeroVecValue = (this->*_zeroValueOf)(); });
+            return _zeroVecValue;
+        };
+
+        /**
+         * Returns the name of the dissimilarity, for which the points have been prepared.
+         * @return As stated above.
+         */
+        const std::string& getDissimilarity() const {
+            return _dissimilarity;
+        };
+
+        /**
+         * Returns the parameters of the dissimilarity, for which the points have been prepared (see `SquaredEuclidean::parameters`).
+         * @return As stated above.
+         */
+        const VectorX<double>& getDissimilarityParameters() const {
+            return _dissimilarityParameters;
+        };
+
+        /**
+         * Returns true, if the points have been prepared by the given dissimilarity policy, i.e. by a policy of the same name and with identical parameters.
+         *
+         * @param dissimilarity The dissimilarity policy.
+         * @return As stated above.
+         */
+        template<typename Dissimilarity>
+        bool isPreparedFor(const Dissimilarity& dissimilarity) const {
+            return _dissimilarity == Dissimilarity::name && equalDissimilarityParameters(_dissimilarityParameters, dissimilarity.parameters());
+        };
+
+        /**
+         * Returns the memory mapping, which backs the points (or null, if the points are owned).
+         * @return As stated above.
+         */
+        const std::shared_ptr<const MappedGroundSet<HostDataType>>& getMapping() const {
+            return _mapping;
+        };
+
+        /**
+         * Returns the name of the allocation policy of the points (see `DefaultAllocation`).
+         * @return As stated above.
+         */
+        const char* getAllocation() const {
+            return _allocation;
+        };
+
+    private:
+        MatrixX<HostDataType> _points;
+        std::shared_ptr<HostDataType> _storage; // The points, if they have been allocated by an allocation policy other than the default.
+        unsigned long _storageRows = 0;
+        unsigned long _storageCols = 0;
+        std::shared_ptr<const MappedGroundSet<HostDataType>> _mapping;
+        VectorX<HostDataType> _weights;
+        double _totalWeight;
+        mutable double _zeroVecValue = 0.0;
+        mutable std::once_flag _zeroVecOnce;
+        double (GroundSet::*_zeroValueOf)() const = nullptr; // Computes `_zeroVecValue` on first use (or null, if it is known).
+        std::string _dissimilarity;
+        VectorX<double> _dissimilarityParameters;
+        unsigned int _workerCount;
+
+        const char* _allocation = DefaultAllocation::name;
+
+        // The number of points, whose dissimilarities to the zero vector are held at once (see `zeroValue`).
+        static constexpr unsigned long ZeroValueTileRows = 256 * ReductionBlockSize;
+
+        GroundSet(MatrixX<HostDataType> points, std::shared_ptr<const MappedGroundSet<HostDataType>> mapping, VectorX<HostDataType> weights, double totalWeight,
+                  std::string dissimilarity, VectorX<double> dissimilarityParameters, int workerCount) :
+            _points(std::move(points)),
+            _mapping(std::move(mapping)), _weights(std::move(weights)), _totalWeight(totalWeight), _dissimilarity(std::move(dissimilarity)),
+            _dissimilarityParameters(std::move(dissimilarityParameters)) {
+            _workerCount = resolveWorkerCount(workerCount);
+        };
+
+        /**
+         * Prepares the points with the given dissimilarity and places them into memory of the given allocation policy.
+         */
+        template<typename Dissimilarity, typename Allocation, typename Points>
+        static std::shared_ptr<const GroundSet> build(Points&& points, VectorX<HostDataType> weights, double totalWeight, const Dissimilarity& dissimilarity,
+                                                      int workerCount) {
+            std::shared_ptr<GroundSet> groundSet(
+                new GroundSet(MatrixX<HostDataType>(), nullptr, std::move(weights), totalWeight, Dissimilarity::name, dissimilarity.parameters(), workerCount));
+            groundSet->_allocation = Allocation::name;
+            if constexpr (std::is_same<Allocation, DefaultAllocation>::value) {
+                groundSet->_points = std::forward<Points>(points);
+                dissimilarity.prepare(groundSet->_points);
+            } else {
+                const MatrixX<HostDataType>& source = points;
+                const long rows = source.rows(), cols = source.cols();
+                groundSet->_storageRows = rows;
+                groundSet->_storageCols = cols;
+                groundSet->_storage = allocateShared<HostDataType, Allocation>(source.size());
+
+                // The rows are copied in the (static) schedule of the distance kernels, hence the pages are touched first by the thread, which scans them.
+                HostDataType* storage = groundSet->_storage.get();
+                const HostDataType* data = source.data();
+#pragma omp parallel for num_threads(groundSet->_workerCount) schedule(static)
+                for (long i = 0; i < rows; i++)
+                    std::copy(data + i * cols, data + (i + 1) * cols, storage + i * cols);
+                Eigen::Map<MatrixX<HostDataType>> prepared(storage, rows, cols);
+                dissimilarity.prepare(prepared);
+            }
+            groundSet->checkWeights();
+            groundSet->_zeroVecValue = groundSet->template zeroValue<Dissimilarity>();
+            return groundSet;
+        };
+
+        /**
+         * Throws, if the number of weights does not match the number of points.
+         */
+        void checkWeights() const {
+            if (_weights.size() > 0 && static_cast<unsigned long>(_weights.size()) != rows())
+                throw std::runtime_error("GroundSet::GroundSet: The number of weights does not match the number of points (" + std::to_string(_weights.size()) + " vs. "
+                                         + std::to_string(rows()) + ").");
+        };
+
+        /**
+         * Computes \f$L(\{0\})\f$ with the given dissimilarity. The dissimilarities are computed in tiles of whole reduction blocks, hence the result equals the
+         * compensated `reduceSum` over all points without holding a dissimilarity per point.
+         */
+        template<typename Dissimilarity>
+        double zeroValue() const {
+            const unsigned long n = rows();
+            if (n == 0)
+                return 0.0;
+            const unsigned long tileRows = std::min(n, ZeroValueTileRows);
+            auto V = matrix();
+            MatrixX<HostDataType> zeroVec = VectorX<HostDataType>::Zero(cols()).transpose();
+            VectorX<HostDataType> distances(tileRows);
+            std::vector<double> blockSums((n + ReductionBlockSize - 1) / ReductionBlockSize);
+            for (unsigned long begin = 0; begin < n; begin += tileRows) {
+                const unsigned long length = std::min(tileRows, n - begin);
+                kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(V.middleRows(begin, length), zeroVec, distances.data(), _workerCount);
+                if (_weights.size() > 0)
+                    distances.head(length).array() *= _weights.segment(begin, length).array();
+
+                const unsigned long blockCount = (length + ReductionBlockSize - 1) / ReductionBlockSize;
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+                for (unsigned long b = 0; b < blockCount; b++)
+                    blockSums[begin / ReductionBlockSize + b] =
+                        blockSum(distances.data() + b * ReductionBlockSize, std::min(ReductionBlockSize, length - b * ReductionBlockSize), ReductionMode::Compensated);
+            }
+            return pairwiseSum(blockSums.data(), blockSums.size()) / (_weights.size() > 0 ? _totalWeight : static_cast<double>(n));
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_GROUNDSET
@@ -0,0 +1,121 @@
+#ifndef EXEMCL_FUNCTION_CPU_HALF
+#define EXEMCL_FUNCTION_CPU_HALF
+
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/HalfPrecisionKernels.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * This class provides a CPU implementation of the submodular function of exemplar-based clustering, which stores the ground set and all evaluated sets in 16-bit
+     * floating point formats (IEEE half precision or bfloat16). Distances are computed by widening the elements to float32 within the kernel (see
+     * `halfprecision::squaredDistance`), such that all accumulations are carried out in float32. Compared to float32 storage, memory and bandwidth requirements are halved.
+     */
+    template<typename StorageDataType = Eigen::half>
+    class HalfPrecisionExemplarClusteringSubmodularFunction : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+        static_assert(std::is_same<StorageDataType, Eigen::half>::value || std::is_same<StorageDataType, Eigen::bfloat16>::value,
+                      "StorageDataType needs to be either Eigen::half or Eigen::bfloat16.");
+
+        /**
+         * Constructs the half precision exemplar clustering submodular function using a ground set V.
+         *
+         * @param V The ground set V.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit HalfPrecisionExemplarClusteringSubmodularFunction(const MatrixX<float>& V, int workerCount = -1) :
+            SubmodularFunction(workerCount), _n(V.rows()), _dim(V.cols()), _paddedDim(paddedDim(V.cols())) {
+            _V = convert(V);
+
+            // Evaluate the zero vec value on the converted data.
+            std::vector<StorageDataType> zeroVec(_paddedDim, StorageDataType(0.0f));
+            double zeroVecValue = 0.0;
+#pragma omp parallel for num_threads(_workerCount) reduction(+ : zeroVecValue)
+            for (unsigned long i = 0; i < _n; i++)
+                zeroVecValue += halfprecision::squaredDistance(_V.data() + i * _paddedDim, zeroVec.data(), _paddedDim);
+            _zeroVecValue = zeroVecValue / static_cast<double>(std::max(_n, 1ul));
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            if (S.cols() != _dim)
+                throw std::runtime_error("HalfPrecisionExemplarClusteringSubmodularFunction::operator(): The dimensionality of S does not match the ground set ("
+                                         + std::to_string(S.cols()) + " vs. " + std::to_string(_dim) + ").");
+
+            // Add zero vector to data copy.
+            MatrixX<float> S_copy(S.rows() + 1, S.cols());
+            S_copy.topRows(S.rows()) = S.cast<float>();
+            S_copy.row(S.rows()).setZero();
+
+            return _zeroVecValue - L(convert(S_copy), S_copy.rows());
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const HalfPrecisionExemplarClusteringSubmodularFunction*) (this))->operator()(S);
+        };
+
+        /**
+         * Returns the memory occupied by the converted ground set (in bytes).
+         * @return As stated above.
+         */
+        size_t getMemoryFootprint() const {
+            return _V.size() * sizeof(StorageDataType);
+        };
+
+    private:
+        unsigned long _n;
+        unsigned int _dim;
+        unsigned int _paddedDim;
+        double _zeroVecValue;
+        std::vector<StorageDataType> _V;
+
+        static unsigned int paddedDim(unsigned int dim) {
+            return (dim + halfprecision::Padding - 1) / halfprecision::Padding * halfprecision::Padding;
+        };
+
+        /**
+         * Converts the rows of `X` to the storage format and pads every row with zeros.
+         */
+        std::vector<StorageDataType> convert(const MatrixX<float>& X) const {
+            std::vector<StorageDataType> converted(static_cast<size_t>(X.rows()) * _paddedDim, StorageDataType(0.0f));
+            for (Eigen::Index i = 0; i < X.rows(); i++)
+                for (unsigned int d = 0; d < _dim; d++)
+                    converted[i * _paddedDim + d] = StorageDataType(X(i, d));
+            return converted;
+        };
+
+        /**
+         * Calculates the L function.
+         *
+         * @param S_inner Converted set of data to calculate the L function for.
+         * @param m The number of rows in `S_inner`.
+         * @return L function value.
+         */
+        double L(const std::vector<StorageDataType>& S_inner, Eigen::Index m) const {
+            std::vector<float> accuArray(_n);
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+            for (unsigned long i = 0; i < _n; i++) {
+                float minVal = std::numeric_limits<float>::max();
+                for (Eigen::Index j = 0; j < m; j++)
+                    minVal = std::min(minVal, halfprecision::squaredDistance(_V.data() + i * _paddedDim, S_inner.data() + j * _paddedDim, _paddedDim));
+                accuArray[i] = minVal;
+            }
+
+            return reduceSum(accuArray.data(), _n, _reductionMode, _workerCount, _deterministic) / static_cast<double>(_n);
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_HALF
@@ -0,0 +1,105 @@
+#ifndef EXEMCL_HALFPRECISIONKERNELS_H
+#define EXEMCL_HALFPRECISIONKERNELS_H
+
+#include <cstdint>
+#include <src/io/DataTypes.h>
+#if defined(__F16C__) || defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+namespace exemcl::cpu::halfprecision {
+    /**
+     * Vectors passed to `squaredDistance` need to be padded (with zeros) to a multiple of this number of elements.
+     */
+    constexpr unsigned int Padding = 16;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    /**
+     * Sums up the eight lanes of an AVX register.
+     */
+    inline float horizontalSum(__m256 v) {
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+        return _mm_cvtss_f32(sum);
+    }
+
+    /**
+     * Widens eight bfloat16 values to float32. A bfloat16 value equals the upper half of the corresponding float32 value, hence the conversion is a plain shift.
+     */
+    inline __m256 loadBFloat16(const uint16_t* ptr) {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) ptr)), 16));
+    }
+#endif
+
+    /**
+     * Calculates the squared euclidean distance between two IEEE half precision vectors. Elements are widened to float32 (using F16C or AVX-512 conversions) and the
+     * distance is accumulated in float32.
+     *
+     * @param a First vector.
+     * @param b Second vector.
+     * @param len Length of both vectors, which needs to be a multiple of `Padding`.
+     * @return The squared distance.
+     */
+    inline float squaredDistance(const Eigen::half* a, const Eigen::half* b, unsigned int len) {
+#if defined(__AVX512F__)
+        __m512 accu = _mm512_setzero_ps();
+        for (unsigned int i = 0; i < len; i += 16) {
+            __m512 diff = _mm512_sub_ps(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*) (a + i))), _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*) (b + i))));
+            accu = _mm512_fmadd_ps(diff, diff, accu);
+        }
+        return _mm512_reduce_add_ps(accu);
+#elif defined(__F16C__) && defined(__AVX2__) && defined(__FMA__)
+        __m256 accu = _mm256_setzero_ps();
+        for (unsigned int i = 0; i < len; i += 8) {
+            __m256 diff = _mm256_sub_ps(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (a + i))), _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (b + i))));
+            accu = _mm256_fmadd_ps(diff, diff, accu);
+        }
+        return horizontalSum(accu);
+#else
+        float accu = 0.0f;
+        for (unsigned int i = 0; i < len; i++) {
+            float diff = static_cast<float>(a[i]) - static_cast<float>(b[i]);
+            accu += diff * diff;
+        }
+        return accu;
+#endif
+    }
+
+    /**
+     * Calculates the squared euclidean distance between two bfloat16 vectors. Elements are widened to float32 and the distance is accumulated in float32.
+     *
+     * @param a First vector.
+     * @param b Second vector.
+     * @param len Length of both vectors, which needs to be a multiple of `Padding`.
+     * @return The squared distance.
+     */
+    inline float squaredDistance(const Eigen::bfloat16* a, const Eigen::bfloat16* b, unsigned int len) {
+#if defined(__AVX512F__)
+        __m512 accu = _mm512_setzero_ps();
+        for (unsigned int i = 0; i < len; i += 16) {
+            __m512 aWide = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*) (a + i))), 16));
+            __m512 bWide = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*) (b + i))), 16));
+            __m512 diff = _mm512_sub_ps(aWide, bWide);
+            accu = _mm512_fmadd_ps(diff, diff, accu);
+        }
+        return _mm512_reduce_add_ps(accu);
+#elif defined(__AVX2__) && defined(__FMA__)
+        __m256 accu = _mm256_setzero_ps();
+        for (unsigned int i = 0; i < len; i += 8) {
+            __m256 diff = _mm256_sub_ps(loadBFloat16((const uint16_t*) (a + i)), loadBFloat16((const uint16_t*) (b + i)));
+            accu = _mm256_fmadd_ps(diff, diff, accu);
+        }
+        return horizontalSum(accu);
+#else
+        float accu = 0.0f;
+        for (unsigned int i = 0; i < len; i++) {
+            float diff = static_cast<float>(a[i]) - static_cast<float>(b[i]);
+            accu += diff * diff;
+        }
+        return accu;
+#endif
+    }
+}
+
+#endif // EXEMCL_HALFPRECISIONKERNELS_H
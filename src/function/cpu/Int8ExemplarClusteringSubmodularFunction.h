@@ -0,0 +1,152 @@
+#ifndef EXEMCL_FUNCTION_CPU_INT8
+#define EXEMCL_FUNCTION_CPU_INT8
+
+#include <cmath>
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/Int8Kernels.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * This class provides an approximate CPU implementation of the submodular function of exemplar-based clustering, which stores the ground set as 8-bit integers.
+     *
+     * Every dimension \f$d\f$ of V is quantized with its own scale \f$a_d\f$ and zero point \f$m_d\f$, i.e. \f$v_d \approx a_d q_d + m_d\f$ with \f$q_d \in [0, 255]\f$. The
+     * squared distance to an exemplar \f$s\f$ is evaluated as \f$\|v\|^2 + \|s\|^2 - 2 \langle v, s \rangle\f$, where
+     * \f$\langle v, s \rangle = \sum_d q_d (a_d s_d) + \sum_d m_d s_d\f$. The scaled exemplar \f$(a_d s_d)_d\f$ is quantized on the fly to signed 8-bit integers, such that the
+     * first sum becomes an integer dot product accumulated in 32 bits (see `int8::dotU8S8`), whereas the second sum is computed exactly once per exemplar.
+     */
+    class Int8ExemplarClusteringSubmodularFunction : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+
+        /**
+         * Constructs the int8 exemplar clustering submodular function using a ground set V.
+         *
+         * @param V The ground set V.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit Int8ExemplarClusteringSubmodularFunction(const MatrixX<float>& V, int workerCount = -1) :
+            SubmodularFunction(workerCount), _n(V.rows()), _dim(V.cols()), _paddedDim((V.cols() + int8::Padding - 1) / int8::Padding * int8::Padding) {
+            // Determine per-dimension scales and zero points.
+            _scales.resize(_dim);
+            _zeroPoints.resize(_dim);
+            for (unsigned int d = 0; d < _dim; d++) {
+                float minVal = _n > 0 ? V.col(d).minCoeff() : 0.0f;
+                float maxVal = _n > 0 ? V.col(d).maxCoeff() : 0.0f;
+                _scales[d] = maxVal > minVal ? (maxVal - minVal) / 255.0f : 1.0f;
+                _zeroPoints[d] = minVal;
+            }
+
+            // Quantize V and compute the norms of the reconstructed vectors.
+            _codes.assign(static_cast<size_t>(_n) * _paddedDim, 0);
+            _norms.resize(_n);
+            double zeroVecValue = 0.0;
+#pragma omp parallel for num_threads(_workerCount) reduction(+ : zeroVecValue)
+            for (unsigned long i = 0; i < _n; i++) {
+                float norm = 0.0f;
+                for (unsigned int d = 0; d < _dim; d++) {
+                    float q = std::round((V(i, d) - _zeroPoints[d]) / _scales[d]);
+                    q = std::min(std::max(q, 0.0f), 255.0f);
+                    _codes[i * _paddedDim + d] = static_cast<uint8_t>(q);
+                    float reconstructed = _scales[d] * q + _zeroPoints[d];
+                    norm += reconstructed * reconstructed;
+                }
+                _norms[i] = norm;
+                zeroVecValue += V.row(i).squaredNorm();
+            }
+            _zeroVecValue = zeroVecValue / static_cast<double>(std::max(_n, 1ul));
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            if (S.cols() != _dim)
+                throw std::runtime_error("Int8ExemplarClusteringSubmodularFunction::operator(): The dimensionality of S does not match the ground set (" + std::to_string(S.cols())
+                                         + " vs. " + std::to_string(_dim) + ").");
+
+            // Add zero vector to data copy.
+            MatrixX<float> S_copy(S.rows() + 1, S.cols());
+            S_copy.topRows(S.rows()) = S.cast<float>();
+            S_copy.row(S.rows()).setZero();
+
+            return _zeroVecValue - L(S_copy);
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const Int8ExemplarClusteringSubmodularFunction*) (this))->operator()(S);
+        };
+
+        /**
+         * Returns the memory occupied by the quantized ground set, including norms, scales and zero points (in bytes).
+         * @return As stated above.
+         */
+        size_t getMemoryFootprint() const {
+            return _codes.size() * sizeof(uint8_t) + _norms.size() * sizeof(float) + (_scales.size() + _zeroPoints.size()) * sizeof(float);
+        };
+
+    private:
+        unsigned long _n;
+        unsigned int _dim;
+        unsigned int _paddedDim;
+        double _zeroVecValue;
+        std::vector<uint8_t> _codes;
+        std::vector<float> _norms;
+        std::vector<float> _scales;
+        std::vector<float> _zeroPoints;
+
+        /**
+         * Calculates the L function using integer dot products.
+         *
+         * @param S_inner Set of data to calculate the L function for.
+         * @return L function value.
+         */
+        double L(const MatrixX<float>& S_inner) const {
+            const Eigen::Index m = S_inner.rows();
+
+            // Quantize the exemplars.
+            std::vector<int8_t> queries(static_cast<size_t>(m) * _paddedDim, 0);
+            std::vector<float> queryScales(m), queryOffsets(m), queryNorms(m);
+            for (Eigen::Index j = 0; j < m; j++) {
+                float maxAbs = 0.0f;
+                float offset = 0.0f;
+                for (unsigned int d = 0; d < _dim; d++) {
+                    maxAbs = std::max(maxAbs, std::abs(_scales[d] * S_inner(j, d)));
+                    offset += _zeroPoints[d] * S_inner(j, d);
+                }
+                float queryScale = maxAbs > 0.0f ? maxAbs / static_cast<float>(int8::SignedMax) : 1.0f;
+                for (unsigned int d = 0; d < _dim; d++)
+                    queries[j * _paddedDim + d] = static_cast<int8_t>(std::round(_scales[d] * S_inner(j, d) / queryScale));
+
+                queryScales[j] = queryScale;
+                queryOffsets[j] = offset;
+                queryNorms[j] = S_inner.row(j).squaredNorm();
+            }
+
+            std::vector<float> accuArray(_n);
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+            for (unsigned long i = 0; i < _n; i++) {
+                const uint8_t* code = _codes.data() + i * _paddedDim;
+                float minVal = std::numeric_limits<float>::max();
+                for (Eigen::Index j = 0; j < m; j++) {
+                    float dot = queryScales[j] * static_cast<float>(int8::dotU8S8(code, queries.data() + j * _paddedDim, _paddedDim)) + queryOffsets[j];
+                    minVal = std::min(minVal, _norms[i] + queryNorms[j] - 2.0f * dot);
+                }
+                accuArray[i] = std::max(minVal, 0.0f);
+            }
+
+            return reduceSum(accuArray.data(), _n, _reductionMode, _workerCount, _deterministic) / static_cast<double>(_n);
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_INT8
@@ -0,0 +1,105 @@
+#ifndef EXEMCL_INT8KERNELS_H
+#define EXEMCL_INT8KERNELS_H
+
+#include <cstdint>
+#if defined(__AVX2__) || defined(__AVX512VNNI__) || defined(__AVXVNNI__)
+#include <immintrin.h>
+#endif
+
+namespace exemcl::cpu::int8 {
+    /**
+     * Vectors passed to `dotU8S8` need to be padded (with zeros) to a multiple of this number of bytes.
+     */
+    constexpr unsigned int Padding = 16;
+
+    /**
+     * The largest magnitude a signed operand of `dotU8S8` may take. The AVX2 kernel multiplies pairs of bytes into saturating 16-bit sums (`vpmaddubsw`), hence
+     * \f$2 \cdot 255 \cdot q\f$ needs to fit into an int16, which requires \f$q \leq 64\f$. VNNI instructions accumulate into 32-bit integers directly.
+     */
+#if (defined(__AVX512VNNI__) && defined(__AVX512VL__)) || defined(__AVXVNNI__) || !defined(__AVX2__)
+    constexpr int SignedMax = 127;
+#else
+    constexpr int SignedMax = 63;
+#endif
+
+    /**
+     * Returns the name of the kernel, which has been selected at compile time.
+     * @return As stated above.
+     */
+    inline const char* kernelName() {
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        return "avx512-vnni";
+#elif defined(__AVXVNNI__)
+        return "avx-vnni";
+#elif defined(__AVX2__)
+        return "avx2";
+#else
+        return "scalar";
+#endif
+    }
+
+#if defined(__AVX2__)
+    /**
+     * Sums up the eight 32-bit lanes of an AVX register.
+     */
+    inline int32_t horizontalSum(__m256i v) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+#endif
+
+    /**
+     * Calculates the dot product of an unsigned and a signed 8-bit integer vector, accumulated in 32-bit integers.
+     *
+     * @param a Unsigned operand.
+     * @param b Signed operand, whose elements need to be within `[-SignedMax, SignedMax]`.
+     * @param len Length of both vectors, which needs to be a multiple of `Padding`.
+     * @return The dot product.
+     */
+    inline int32_t dotU8S8(const uint8_t* a, const int8_t* b, unsigned int len) {
+        unsigned int i = 0;
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+        __m512i accu512 = _mm512_setzero_si512();
+        for (; i + 64 <= len; i += 64)
+            accu512 = _mm512_dpbusd_epi32(accu512, _mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        __m256i accu256 = _mm256_add_epi32(_mm512_castsi512_si256(accu512), _mm512_extracti64x4_epi64(accu512, 1));
+        for (; i + 32 <= len; i += 32)
+            accu256 = _mm256_dpbusd_epi32(accu256, _mm256_loadu_si256((const __m256i*) (a + i)), _mm256_loadu_si256((const __m256i*) (b + i)));
+        __m128i accu128 = _mm_setzero_si128();
+        for (; i < len; i += 16)
+            accu128 = _mm_dpbusd_epi32(accu128, _mm_loadu_si128((const __m128i*) (a + i)), _mm_loadu_si128((const __m128i*) (b + i)));
+        return horizontalSum(_mm256_add_epi32(accu256, _mm256_zextsi128_si256(accu128)));
+#elif defined(__AVXVNNI__)
+        __m256i accu256 = _mm256_setzero_si256();
+        for (; i + 32 <= len; i += 32)
+            accu256 = _mm256_dpbusd_avx_epi32(accu256, _mm256_loadu_si256((const __m256i*) (a + i)), _mm256_loadu_si256((const __m256i*) (b + i)));
+        __m128i accu128 = _mm_setzero_si128();
+        for (; i < len; i += 16)
+            accu128 = _mm_dpbusd_avx_epi32(accu128, _mm_loadu_si128((const __m128i*) (a + i)), _mm_loadu_si128((const __m128i*) (b + i)));
+        return horizontalSum(_mm256_add_epi32(accu256, _mm256_zextsi128_si256(accu128)));
+#elif defined(__AVX2__)
+        const __m256i ones256 = _mm256_set1_epi16(1);
+        __m256i accu256 = _mm256_setzero_si256();
+        for (; i + 32 <= len; i += 32) {
+            __m256i products = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*) (a + i)), _mm256_loadu_si256((const __m256i*) (b + i)));
+            accu256 = _mm256_add_epi32(accu256, _mm256_madd_epi16(products, ones256));
+        }
+        const __m128i ones128 = _mm_set1_epi16(1);
+        __m128i accu128 = _mm_setzero_si128();
+        for (; i < len; i += 16) {
+            __m128i products = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*) (a + i)), _mm_loadu_si128((const __m128i*) (b + i)));
+            accu128 = _mm_add_epi32(accu128, _mm_madd_epi16(products, ones128));
+        }
+        return horizontalSum(_mm256_add_epi32(accu256, _mm256_zextsi128_si256(accu128)));
+#else
+        int32_t accu = 0;
+        for (; i < len; i++)
+            accu += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+        return accu;
+#endif
+    }
+}
+
+#endif // EXEMCL_INT8KERNELS_H
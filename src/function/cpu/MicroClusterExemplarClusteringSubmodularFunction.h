@@ -0,0 +1,231 @@
+#ifndef EXEMCL_FUNCTION_CPU_MICROCLUSTER
+#define EXEMCL_FUNCTION_CPU_MICROCLUSTER
+
+#include <cmath>
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/BallTree.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * Holds the outcome of an adaptive evaluation by `MicroClusterExemplarClusteringSubmodularFunction`.
+     */
+    struct MicroClusterEvaluation {
+        double value = 0.0;                // The estimate of f(S), i.e. the center of the bounds.
+        double lower = 0.0;                // The lower bound of f(S).
+        double upper = 0.0;                // The upper bound of f(S).
+        unsigned long visitedNodes = 0;    // The number of summary tree nodes, whose bounds have been computed.
+        unsigned long evaluatedPoints = 0; // The number of points of V, which have been evaluated exactly.
+    };
+
+    /**
+     * This class provides an adaptive-precision CPU implementation of the submodular function of exemplar-based clustering (using the squared Euclidean distance), which
+     * evaluates L on a hierarchical micro-cluster summary of V (similar to the CF tree of BIRCH, see Zhang, Ramakrishnan and Livny, 1996).
+     *
+     * The summary tree shares its structure with `BallTree`. Every node stores the clustering feature of its points, i.e. the count \f$n\f$, the centroid \f$c\f$, the
+     * radius \f$r\f$ and the mean squared deviation \f$\sigma^2 = \frac{1}{n} \sum_v \|v - c\|^2\f$. The contribution \f$\sum_v \min_{s \in S} \|v - s\|^2\f$ of a node is
+     * then bounded by
+     * \f[ n \max(0, \min_{s \in S} \|c - s\| - r)^2 \leq \sum_v \min_{s \in S} \|v - s\|^2 \leq n (\min_{s \in S} \|c - s\|^2 + \sigma^2). \f]
+     * Starting at the root, a node is only expanded, if its bounds differ by more than `tolerance` times its count, whereas the points of expanded leaves are evaluated
+     * exactly. Hence, the bounds of f(S) differ by at most `tolerance`, and the cost of an evaluation depends on the requested accuracy rather than on \f$|V|\f$. A
+     * tolerance of zero evaluates f(S) exactly.
+     */
+    template<typename HostDataType = float>
+    class MicroClusterExemplarClusteringSubmodularFunction : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+
+        /**
+         * Constructs the micro-cluster exemplar clustering submodular function using a ground set V.
+         *
+         * @param V The ground set V.
+         * @param tolerance The maximum difference between the bounds of f(S).
+         * @param leafSize The maximum number of points stored in a leaf node of the summary tree.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit MicroClusterExemplarClusteringSubmodularFunction(const MatrixX<HostDataType>& V, double tolerance = 0.0, unsigned int leafSize = 32, int workerCount = -1) :
+            SubmodularFunction(workerCount), _tree(V, leafSize) {
+            setTolerance(tolerance);
+
+            // Compute the clustering features in double precision, such that the centroid decomposition of the upper bound holds up to rounding errors.
+            const auto& nodes = _tree.getNodes();
+            const auto& points = _tree.getPoints();
+            _centroids.resize(nodes.size());
+            _radii.resize(nodes.size());
+            _variances.resize(nodes.size());
+#pragma omp parallel for num_threads(_workerCount) schedule(dynamic)
+            for (unsigned long k = 0; k < nodes.size(); k++) {
+                const auto& node = nodes[k];
+                const double count = static_cast<double>(node.end - node.begin);
+                VectorX<double> centroid = points.middleRows(node.begin, node.end - node.begin).template cast<double>().colwise().sum().transpose() / count;
+                double radius = 0.0, variance = 0.0;
+                for (unsigned long i = node.begin; i < node.end; i++) {
+                    double squaredDistance = (points.row(i).template cast<double>().transpose() - centroid).squaredNorm();
+                    radius = std::max(radius, squaredDistance);
+                    variance += squaredDistance;
+                }
+                _centroids[k] = std::move(centroid);
+                _radii[k] = std::sqrt(radius);
+                _variances[k] = variance / count;
+            }
+
+            // L({0}) follows from the clustering feature of the root.
+            _zeroVecValue = nodes.empty() ? 0.0 : _centroids[0].squaredNorm() + _variances[0];
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function up to the configured tolerance.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            return evaluate(S).value;
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function up to the configured tolerance.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const MicroClusterExemplarClusteringSubmodularFunction*) (this))->operator()(S);
+        };
+
+        /**
+         * Calculates a lower and an upper bound for the function value of `S`, which differ by at most the configured tolerance.
+         *
+         * @param S The set to evaluate.
+         * @return A pair \f$(f_{\text{low}}, f_{\text{high}})\f$ with \f$f_{\text{low}} \leq f(S) \leq f_{\text{high}}\f$.
+         */
+        std::pair<double, double> bounds(const MatrixX<double>& S) const {
+            auto evaluation = evaluate(S);
+            return {evaluation.lower, evaluation.upper};
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function adaptively, expanding the summary tree breadth-first.
+         *
+         * @param S The set to evaluate.
+         * @return The estimate, the bounds and the cost of the evaluation.
+         */
+        MicroClusterEvaluation evaluate(const MatrixX<double>& S) const {
+            const auto& nodes = _tree.getNodes();
+            const auto& points = _tree.getPoints();
+            if (S.cols() != points.cols())
+                throw std::runtime_error("MicroClusterExemplarClusteringSubmodularFunction::evaluate: The dimensionality of S does not match the ground set ("
+                                         + std::to_string(S.cols()) + " vs. " + std::to_string(points.cols()) + ").");
+
+            // Add zero vector to data copy.
+            MatrixX<double> S_copy(S.rows() + 1, S.cols());
+            S_copy.topRows(S.rows()) = S;
+            S_copy.row(S.rows()).setZero();
+            const MatrixX<HostDataType> S_host = S_copy.cast<HostDataType>();
+
+            MicroClusterEvaluation evaluation;
+            double lowerSum = 0.0, upperSum = 0.0;
+            std::vector<unsigned long> frontier;
+            if (!nodes.empty())
+                frontier.push_back(0);
+
+            while (!frontier.empty()) {
+                std::vector<double> lower(frontier.size()), upper(frontier.size());
+                std::vector<char> expand(frontier.size(), 0);
+                unsigned long evaluatedPoints = 0;
+
+#pragma omp parallel num_threads(_workerCount) reduction(+ : evaluatedPoints)
+                {
+                    // Leaves are evaluated by a single thread each, hence the buffers are per thread.
+                    std::vector<HostDataType> distances;
+                    std::vector<double> blockSums;
+#pragma omp for schedule(dynamic)
+                    for (unsigned long f = 0; f < frontier.size(); f++) {
+                        const unsigned long k = frontier[f];
+                        const auto& node = nodes[k];
+                        const double count = static_cast<double>(node.end - node.begin);
+
+                        double minCenterDistance = std::numeric_limits<double>::max();
+                        for (Eigen::Index j = 0; j < S_copy.rows(); j++)
+                            minCenterDistance = std::min(minCenterDistance, (S_copy.row(j).transpose() - _centroids[k]).squaredNorm());
+
+                        // The lower bound is slightly relaxed, such that rounding errors never cause it to exceed the true contribution.
+                        const double relax = 4 * std::numeric_limits<double>::epsilon();
+                        const double gap = std::sqrt(minCenterDistance) * (1 - relax) - _radii[k] * (1 + relax);
+                        lower[f] = gap > 0.0 ? count * gap * gap : 0.0;
+                        upper[f] = count * (minCenterDistance + _variances[k]);
+
+                        if (upper[f] - lower[f] <= _tolerance * count)
+                            continue;
+                        if (node.isLeaf()) {
+                            const unsigned long length = node.end - node.begin;
+                            distances.resize(std::max<std::size_t>(distances.size(), length));
+                            kernels::dispatchMinDissimilarities<HostDataType>(points.middleRows(node.begin, length), S_host, distances.data(), 1);
+                            lower[f] = upper[f] = reduceSum(distances.data(), length, _reductionMode, 1, _deterministic, blockSums);
+                            evaluatedPoints += length;
+                        } else
+                            expand[f] = 1;
+                    }
+                }
+
+                // Accumulate the settled nodes and descend into the remaining ones.
+                std::vector<unsigned long> next;
+                for (unsigned long f = 0; f < frontier.size(); f++) {
+                    if (expand[f]) {
+                        next.push_back(nodes[frontier[f]].left);
+                        next.push_back(nodes[frontier[f]].right);
+                    } else {
+                        lowerSum += lower[f];
+                        upperSum += upper[f];
+                    }
+                }
+                evaluation.visitedNodes += frontier.size();
+                evaluation.evaluatedPoints += evaluatedPoints;
+                frontier = std::move(next);
+            }
+
+            const double n = static_cast<double>(std::max<Eigen::Index>(points.rows(), 1));
+            evaluation.lower = _zeroVecValue - upperSum / n;
+            evaluation.upper = _zeroVecValue - lowerSum / n;
+            evaluation.value = 0.5 * (evaluation.lower + evaluation.upper);
+            return evaluation;
+        };
+
+        /**
+         * Returns the maximum difference between the bounds of f(S).
+         * @return As stated above.
+         */
+        double getTolerance() const {
+            return _tolerance;
+        };
+
+        /**
+         * Updates the maximum difference between the bounds of f(S).
+         * @param tolerance New tolerance.
+         */
+        void setTolerance(double tolerance) {
+            if (tolerance < 0.0)
+                throw std::runtime_error("MicroClusterExemplarClusteringSubmodularFunction::setTolerance: The tolerance must not be negative.");
+            _tolerance = tolerance;
+        };
+
+        /**
+         * Returns the summary tree.
+         * @return As stated above.
+         */
+        const BallTree<HostDataType>& getTree() const {
+            return _tree;
+        };
+
+    private:
+        BallTree<HostDataType> _tree;
+        std::vector<VectorX<double>> _centroids;
+        std::vector<double> _radii;
+        std::vector<double> _variances;
+        double _zeroVecValue;
+        double _tolerance;
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_MICROCLUSTER
@@ -0,0 +1,307 @@
+#ifndef EXEMCL_FUNCTION_CPU_NUMAGROUNDSET
+#define EXEMCL_FUNCTION_CPU_NUMAGROUNDSET
+
+#include <mutex>
+#include <omp.h>
+#include <src/function/Reduction.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <src/function/cpu/GroundSet.h>
+#include <src/function/cpu/NumaTopology.h>
+#include <sys/mman.h>
+
+namespace exemcl::cpu {
+    /**
+     * Selects, how the shards of a `NumaGroundSet` are placed onto their nodes.
+     */
+    enum class NumaPlacement {
+        FirstTouch, // Every shard is copied by threads pinned to its node, hence the kernel allocates the pages locally (unless the node runs out of memory).
+        Bind        // Every shard is bound to its node (see `NumaTopology::bind`) before it is copied.
+    };
+
+    /**
+     * A copy of a prepared ground set (see `GroundSet`), which is partitioned into one shard per NUMA node. Shards hold a contiguous range of points (alongside their
+     * weights), whose size is proportional to the number of CPUs of the node, and are allocated in the memory of their node.
+     *
+     * Evaluations run one team of threads per node, which is pinned to the node and only reads its shard, hence V never crosses the socket interconnect. The (small)
+     * evaluated set is replicated into a buffer of every node, which is kept alongside the per-thread dissimilarities for later evaluations, hence evaluations of sets
+     * of a given shape allocate nothing in steady state. Since these buffers are shared, evaluations are serialized (each of them employs all nodes).
+     *
+     * Shards start at multiples of `ReductionBlockSize`, hence the per-node partial sums of the compensated and the deterministic reduction are combined in the same
+     * fixed tree as `reduceSum`, i.e. the result is bit-identical to the evaluation of the unpartitioned ground set.
+     */
+    template<typename HostDataType = float>
+    class NumaGroundSet {
+    public:
+        /**
+         * Partitions the ground set and copies every shard onto its node.
+         *
+         * @param groundSet The ground set to partition.
+         * @param topology The nodes, which receive a shard.
+         * @param placement Selects, how the shards are placed.
+         * @param workerCount The number of workers to employ for the copy (defaults to -1, i.e. all CPUs of the topology).
+         */
+        NumaGroundSet(const GroundSet<HostDataType>& groundSet, NumaTopology topology = NumaTopology::detect(), NumaPlacement placement = NumaPlacement::FirstTouch,
+                      int workerCount = -1) :
+            _topology(std::move(topology)),
+            _placement(placement), _rows(groundSet.rows()), _cols(groundSet.cols()), _weighted(groundSet.getWeights().size() > 0) {
+            auto V = groundSet.matrix();
+            const VectorX<HostDataType>& weights = groundSet.getWeights();
+
+            // Assign a range of blocks to every node, which is proportional to its number of CPUs.
+            const unsigned long blockCount = (_rows + ReductionBlockSize - 1) / ReductionBlockSize;
+            const unsigned long cpuCount = _topology.cpuCount();
+            unsigned long cpus = 0;
+            for (auto& node : _topology.getNodes()) {
+                Shard shard;
+                shard.firstBlock = blockCount * cpus / cpuCount;
+                cpus += node.cpus.size();
+                shard.blockCount = blockCount * cpus / cpuCount - shard.firstBlock;
+                shard.firstRow = shard.firstBlock * ReductionBlockSize;
+                shard.rows = std::min(_rows, (shard.firstBlock + shard.blockCount) * ReductionBlockSize) - std::min(_rows, shard.firstRow);
+                _shards.push_back(shard);
+            }
+
+            // Reserve the (untouched) memory of every shard.
+            for (unsigned long k = 0; k < _shards.size(); k++) {
+                Shard& shard = _shards[k];
+                shard.length = shard.rows * (_cols + (_weighted ? 1 : 0)) * sizeof(HostDataType);
+                if (shard.length == 0)
+                    continue;
+                void* base = mmap(nullptr, shard.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (base == MAP_FAILED) {
+                    release();
+                    throw std::runtime_error("NumaGroundSet::NumaGroundSet: Unable to allocate " + std::to_string(shard.length) + " byte for the shard of node "
+                                             + std::to_string(_topology.getNodes()[k].id) + " (" + std::strerror(errno) + ").");
+                }
+                shard.base = base;
+                shard.points = static_cast<HostDataType*>(base);
+                shard.weights = _weighted ? shard.points + shard.rows * _cols : nullptr;
+                if (_placement == NumaPlacement::Bind) {
+                    try {
+                        NumaTopology::bind(base, shard.length, _topology.getNodes()[k]);
+                    } catch (...) {
+                        release();
+                        throw;
+                    }
+                }
+            }
+
+            // Every thread copies the rows, which it evaluates later on, hence the pages are touched first by a thread of the owning node.
+            run(
+                workerCount >= 1 ? workerCount : _topology.cpuCount(), [](unsigned long) {},
+                [&](unsigned long k, unsigned long begin, unsigned long end) {
+                    Shard& shard = _shards[k];
+                    const unsigned long length = end - begin;
+                    Eigen::Map<MatrixX<HostDataType>>(shard.points + (begin - shard.firstRow) * _cols, length, _cols) = V.middleRows(begin, length);
+                    if (_weighted)
+                        Eigen::Map<VectorX<HostDataType>>(shard.weights + (begin - shard.firstRow), length) = weights.segment(begin, length);
+                });
+        };
+
+        NumaGroundSet(const NumaGroundSet&) = delete;
+        NumaGroundSet& operator=(const NumaGroundSet&) = delete;
+
+        /**
+         * Releases the shards.
+         */
+        ~NumaGroundSet() {
+            release();
+        };
+
+        /**
+         * Computes \f$\sum_{v \in V} w_v \min_{s \in S} d(v, s)\f$ (with \f$w_v = 1\f$, if the ground set is unweighted).
+         *
+         * @param S The exemplars (one per row), prepared by the dissimilarity policy and including the zero vector.
+         * @param mode The reduction mode.
+         * @param workerCount The number of threads to employ, which are distributed over the nodes proportionally to their number of CPUs.
+         * @param deterministic Enforces a thread-count independent summation order in naive mode (compensated mode is always deterministic).
+         * @return The sum.
+         */
+        template<typename Dissimilarity = SquaredEuclidean>
+        double sumMinDissimilarities(ConstMatrixXRef<HostDataType> S, ReductionMode mode, unsigned int workerCount, bool deterministic = false) const {
+            std::lock_guard<std::mutex> lock(_scratchMutex);
+            const bool blocked = mode == ReductionMode::Compensated || deterministic;
+            _blockSums.resize(blocked ? (_rows + ReductionBlockSize - 1) / ReductionBlockSize : 0);
+            _scratch.resize(_shards.size());
+
+            run(
+                workerCount,
+                [&](unsigned long k) {
+                    // Replicate S within the memory of the node. The buffers are allocated by a thread of the node, hence they are placed locally on first touch.
+                    Scratch& scratch = _scratch[k];
+                    if (scratch.replica.rows() < S.rows() || scratch.replica.cols() != S.cols())
+                        scratch.replica.resize(std::max(S.rows(), 2 * scratch.replica.rows()), S.cols());
+                    scratch.replica.topRows(S.rows()) = S;
+                    scratch.distances.resize(threadsOf(workerCount, k));
+                    scratch.partialSums.assign(threadsOf(workerCount, k), 0.0);
+                },
+                [&](unsigned long k, unsigned long begin, unsigned long end, unsigned long rank) {
+                    const Shard& shard = _shards[k];
+                    Scratch& scratch = _scratch[k];
+                    const unsigned long length = end - begin;
+                    const unsigned long offset = begin - shard.firstRow;
+                    VectorX<HostDataType>& distances = scratch.distances[rank];
+                    if (static_cast<unsigned long>(distances.size()) < length)
+                        distances.resize(length);
+                    Eigen::Map<const MatrixX<HostDataType>> points(shard.points + offset * _cols, length, _cols);
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(points, scratch.replica.topRows(S.rows()), distances.data(), 1);
+                    if (_weighted)
+                        distances.head(length).array() *= Eigen::Map<const VectorX<HostDataType>>(shard.weights + offset, length).array();
+
+                    if (blocked) {
+                        // `begin` is a multiple of the block size, hence the blocks equal the ones of `reduceSum`.
+                        for (unsigned long b = 0; b * ReductionBlockSize < length; b++)
+                            _blockSums[begin / ReductionBlockSize + b] =
+                                blockSum(distances.data() + b * ReductionBlockSize, std::min(ReductionBlockSize, length - b * ReductionBlockSize), mode);
+                    } else
+                        scratch.partialSums[rank] = reduceSum(distances.data(), length, mode, 1);
+                });
+
+            if (blocked)
+                return pairwiseSum(_blockSums.data(), _blockSums.size());
+
+            // Merge the per-node partial sums.
+            double accu = 0.0;
+            for (unsigned long k = 0; k < _shards.size(); k++)
+                for (double partialSum : _scratch[k].partialSums)
+                    accu += partialSum;
+            return accu;
+        };
+
+        /**
+         * Returns the topology, whose nodes hold the shards.
+         * @return As stated above.
+         */
+        const NumaTopology& getTopology() const {
+            return _topology;
+        };
+
+        /**
+         * Returns the placement of the shards.
+         * @return As stated above.
+         */
+        NumaPlacement getPlacement() const {
+            return _placement;
+        };
+
+        /**
+         * Returns the number of points of the shard of the `k`-th node.
+         *
+         * @param k The index of the node within the topology.
+         * @return As stated above.
+         */
+        unsigned long shardRows(unsigned long k) const {
+            return _shards.at(k).rows;
+        };
+
+        /**
+         * Returns the total number of points.
+         * @return As stated above.
+         */
+        unsigned long rows() const {
+            return _rows;
+        };
+
+    private:
+        /**
+         * A contiguous range of points (and weights), which is allocated on a single node.
+         */
+        struct Shard {
+            unsigned long firstBlock = 0;
+            unsigned long blockCount = 0;
+            unsigned long firstRow = 0;
+            unsigned long rows = 0;
+            void* base = nullptr;
+            unsigned long length = 0;
+            HostDataType* points = nullptr;
+            HostDataType* weights = nullptr;
+        };
+
+        /**
+         * The buffers of the evaluations of a single node, which are reused by later evaluations.
+         */
+        struct Scratch {
+            MatrixX<HostDataType> replica;                // The replica of the evaluated set (which only grows).
+            std::vector<VectorX<HostDataType>> distances; // The dissimilarities of every thread of the node (which only grow).
+            std::vector<double> partialSums;              // The partial sum of every thread of the node (naive mode only).
+        };
+
+        NumaTopology _topology;
+        NumaPlacement _placement;
+        unsigned long _rows;
+        unsigned long _cols;
+        bool _weighted;
+        std::vector<Shard> _shards;
+
+        // Scratch buffers of the evaluations (see `sumMinDissimilarities`), which are held by a single evaluation at a time.
+        mutable std::mutex _scratchMutex;
+        mutable std::vector<Scratch> _scratch;
+        mutable std::vector<double> _blockSums;
+
+        void release() {
+            for (auto& shard : _shards)
+                if (shard.base != nullptr) {
+                    munmap(shard.base, shard.length);
+                    shard.base = nullptr;
+                }
+        };
+
+        /**
+         * Returns the number of threads of the `k`-th node, i.e. its share of `workerCount` (at least one and at most one per block of its shard).
+         */
+        unsigned long threadsOf(unsigned int workerCount, unsigned long k) const {
+            const unsigned long share = (workerCount * _topology.getNodes()[k].cpus.size() + _topology.cpuCount() - 1) / _topology.cpuCount();
+            return std::max<unsigned long>(1, std::min(share, _shards[k].blockCount));
+        };
+
+        /**
+         * Runs one team of threads per node. Every thread is pinned to its node and, after `prologue(k)` has been called once for every node `k`, calls
+         * `body(k, begin, end[, rank])` for a range of blocks of the shard of its node, which is given by row indices of the unpartitioned ground set.
+         *
+         * If the runtime provides fewer threads than requested (e.g. within a nested parallel region), the threads are not pinned and process several ranges each.
+         */
+        template<typename Prologue, typename Body>
+        void run(unsigned int workerCount, Prologue&& prologue, Body&& body) const {
+            // Every slot is a range of blocks, which is processed by a single thread.
+            struct Slot {
+                unsigned long node, rank, begin, end;
+            };
+            std::vector<Slot> slots;
+            for (unsigned long k = 0; k < _shards.size(); k++) {
+                const Shard& shard = _shards[k];
+                const unsigned long threads = threadsOf(workerCount, k);
+                for (unsigned long r = 0; r < threads; r++) {
+                    const unsigned long firstBlock = shard.firstBlock + shard.blockCount * r / threads;
+                    const unsigned long lastBlock = shard.firstBlock + shard.blockCount * (r + 1) / threads;
+                    slots.push_back({k, r, std::min(_rows, firstBlock * ReductionBlockSize), std::min(_rows, lastBlock * ReductionBlockSize)});
+                }
+            }
+
+#pragma omp parallel num_threads(slots.size())
+            {
+                const unsigned long teamSize = omp_get_num_threads();
+                const unsigned long thread = omp_get_thread_num();
+                cpu_set_t previous;
+                const bool pinned = teamSize == slots.size() && NumaTopology::pin(_topology.getNodes()[slots[thread].node], &previous);
+
+                for (unsigned long s = thread; s < slots.size(); s += teamSize)
+                    if (slots[s].rank == 0)
+                        prologue(slots[s].node);
+#pragma omp barrier
+
+                for (unsigned long s = thread; s < slots.size(); s += teamSize)
+                    if (slots[s].end > slots[s].begin) {
+                        if constexpr (std::is_invocable<Body, unsigned long, unsigned long, unsigned long, unsigned long>::value)
+                            body(slots[s].node, slots[s].begin, slots[s].end, slots[s].rank);
+                        else
+                            body(slots[s].node, slots[s].begin, slots[s].end);
+                    }
+
+                if (pinned)
+                    NumaTopology::restore(previous);
+            }
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_NUMAGROUNDSET
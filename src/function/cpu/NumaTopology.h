@@ -0,0 +1,175 @@
+#ifndef EXEMCL_FUNCTION_CPU_NUMATOPOLOGY
+#define EXEMCL_FUNCTION_CPU_NUMATOPOLOGY
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * A NUMA node, i.e. a memory controller alongside the CPUs, which access its memory without crossing the socket interconnect.
+     */
+    struct NumaNode {
+        unsigned int id;                // The id of the node, as used by the kernel's memory policies.
+        std::vector<unsigned int> cpus; // The CPUs of the node, which are available to the process.
+    };
+
+    /**
+     * The NUMA nodes of the host, which are used to partition a ground set (see `NumaGroundSet`). The topology is read from `/sys/devices/system/node` and restricted to
+     * the CPUs, which the process may run on (e.g. within a cpuset). Hosts without NUMA support yield a single node, which holds all available CPUs.
+     */
+    class NumaTopology {
+    public:
+        /**
+         * Creates a topology from a list of nodes, e.g. to split a single node into several partitions. Nodes without CPUs are dropped.
+         *
+         * @param nodes The nodes.
+         */
+        explicit NumaTopology(std::vector<NumaNode> nodes) {
+            for (auto& node : nodes)
+                if (!node.cpus.empty())
+                    _nodes.push_back(std::move(node));
+            if (_nodes.empty())
+                throw std::runtime_error("NumaTopology::NumaTopology: The topology needs to hold at least one node with CPUs.");
+        };
+
+        /**
+         * Detects the topology of the host.
+         * @return As stated above.
+         */
+        static NumaTopology detect() {
+            cpu_set_t available;
+            CPU_ZERO(&available);
+            if (sched_getaffinity(0, sizeof(available), &available) != 0)
+                throw std::runtime_error(std::string("NumaTopology::detect: Unable to query the CPU affinity (") + std::strerror(errno) + ").");
+
+            std::vector<NumaNode> nodes;
+            std::vector<unsigned int> onlineNodes = parseList(readFile("/sys/devices/system/node/online"));
+            for (unsigned int id : onlineNodes) {
+                NumaNode node {id, {}};
+                for (unsigned int cpu : parseList(readFile("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist")))
+                    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &available))
+                        node.cpus.push_back(cpu);
+                nodes.push_back(std::move(node));
+            }
+
+            // Without any (usable) node information, all available CPUs form a single node.
+            if (std::none_of(nodes.begin(), nodes.end(), [](const NumaNode& node) { return !node.cpus.empty(); })) {
+                nodes.assign(1, NumaNode {0, {}});
+                for (unsigned int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                    if (CPU_ISSET(cpu, &available))
+                        nodes[0].cpus.push_back(cpu);
+            }
+            return NumaTopology(std::move(nodes));
+        };
+
+        /**
+         * Returns the nodes.
+         * @return As stated above.
+         */
+        const std::vector<NumaNode>& getNodes() const {
+            return _nodes;
+        };
+
+        /**
+         * Returns the total number of CPUs.
+         * @return As stated above.
+         */
+        unsigned long cpuCount() const {
+            unsigned long count = 0;
+            for (auto& node : _nodes)
+                count += node.cpus.size();
+            return count;
+        };
+
+        /**
+         * Restricts the calling thread to the CPUs of a node.
+         *
+         * @param node The node.
+         * @param previous Receives the previous affinity of the thread (optional), which can be restored by `restore`.
+         * @return True, if the affinity has been changed.
+         */
+        static bool pin(const NumaNode& node, cpu_set_t* previous = nullptr) {
+            if (previous != nullptr && sched_getaffinity(0, sizeof(cpu_set_t), previous) != 0)
+                return false;
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            for (unsigned int cpu : node.cpus)
+                CPU_SET(cpu, &mask);
+            return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+        };
+
+        /**
+         * Restores an affinity of the calling thread, which has been saved by `pin`.
+         *
+         * @param previous The previous affinity.
+         */
+        static void restore(const cpu_set_t& previous) {
+            sched_setaffinity(0, sizeof(previous), &previous);
+        };
+
+        /**
+         * Binds a (not yet touched) memory range to a node, such that its pages are allocated on the node regardless of the thread, which touches them first.
+         *
+         * @param address The beginning of the range (page-aligned).
+         * @param length The length of the range (in bytes).
+         * @param node The node.
+         */
+        static void bind(void* address, unsigned long length, const NumaNode& node) {
+            // The memory policy is set by the raw system call (see mbind(2)), hence the library does not depend on libnuma.
+            constexpr int MemoryPolicyBind = 2; // MPOL_BIND
+            constexpr unsigned long BitsPerWord = 8 * sizeof(unsigned long);
+            std::vector<unsigned long> nodeMask(node.id / BitsPerWord + 1, 0);
+            nodeMask[node.id / BitsPerWord] |= 1ul << (node.id % BitsPerWord);
+            if (syscall(SYS_mbind, address, length, MemoryPolicyBind, nodeMask.data(), nodeMask.size() * BitsPerWord + 1, 0) != 0)
+                throw std::runtime_error("NumaTopology::bind: Unable to bind " + std::to_string(length) + " byte to node " + std::to_string(node.id) + " ("
+                                         + std::strerror(errno) + ").");
+        };
+
+    private:
+        std::vector<NumaNode> _nodes;
+
+        static std::string readFile(const std::string& path) {
+            std::ifstream file(path);
+            std::string content;
+            std::getline(file, content);
+            return content;
+        };
+
+        /**
+         * Parses a list in the format of the kernel (e.g. `0-3,8,10-11`).
+         */
+        static std::vector<unsigned int> parseList(const std::string& list) {
+            std::vector<unsigned int> values;
+            std::size_t position = 0;
+            while (position < list.size()) {
+                std::size_t end = list.find(',', position);
+                if (end == std::string::npos)
+                    end = list.size();
+                const std::string range = list.substr(position, end - position);
+                const std::size_t dash = range.find('-');
+                try {
+                    if (!range.empty()) {
+                        const unsigned long first = std::stoul(range.substr(0, dash));
+                        const unsigned long last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+                        for (unsigned long value = first; value <= last; value++)
+                            values.push_back(value);
+                    }
+                } catch (const std::exception&) {
+                    return {};
+                }
+                position = end + 1;
+            }
+            return values;
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_NUMATOPOLOGY
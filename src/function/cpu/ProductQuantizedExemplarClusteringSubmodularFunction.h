@@ -0,0 +1,167 @@
+#ifndef EXEMCL_FUNCTION_CPU_PQ
+#define EXEMCL_FUNCTION_CPU_PQ
+
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/ApproximationValidation.h>
+#include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/ProductQuantizer.h>
+
+namespace exemcl::cpu {
+    /**
+     * Summarizes memory savings and the observed error of a quantized ground set.
+     */
+    struct QuantizationReport {
+        size_t uncompressedMemory = 0;   // Memory of the ground set at float32 precision (in bytes).
+        size_t compressedMemory = 0;     // Memory of the quantized ground set, including codebooks (in bytes).
+        double meanSquaredError = 0.0;   // Mean squared reconstruction error per point.
+        double maxRelativeError = 0.0;   // Maximum relative error of f(S) w.r.t. the exact float32 function on the validation sets.
+        double meanRelativeError = 0.0;  // Mean relative error of f(S) w.r.t. the exact float32 function on the validation sets.
+        unsigned int validationSets = 0; // The number of validation sets.
+    };
+
+    /**
+     * This class provides an approximate CPU implementation of the submodular function of exemplar-based clustering, which stores the ground set as product-quantized
+     * codes (see `ProductQuantizer`) instead of full-precision vectors. Every \f$v \in V\f$ occupies \f$m\f$ bytes only.
+     *
+     * For every set \f$S\f$ to evaluate, an asymmetric distance lookup table is computed once per exemplar. Hence, the search for \f$\min_{s \in S} \|v - s\|^2\f$ consists of
+     * table lookups only.
+     */
+    class ProductQuantizedExemplarClusteringSubmodularFunction : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+
+        /**
+         * Constructs the product-quantized exemplar clustering submodular function using a ground set V. Validation is opt-in, since it prepares the exact function over a
+         * full-precision copy of V, i.e. it at least doubles the peak memory, which the codes are meant to save.
+         *
+         * @param V The ground set V.
+         * @param subspaces The number of subspaces \f$m\f$ (i.e. bytes per code).
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param validationSets The number of random subsets of V, which are used to measure the error w.r.t. the exact float32 function (defaults to 0, i.e. no validation).
+         * @param seed Seed for the random number generator.
+         */
+        ProductQuantizedExemplarClusteringSubmodularFunction(const MatrixX<float>& V, unsigned int subspaces, int workerCount = -1, unsigned int validationSets = 0,
+                                                             unsigned long seed = 0) :
+            SubmodularFunction(workerCount),
+            _quantizer(V, subspaces, 25, 65536, seed, _workerCount), _n(V.rows()) {
+            _codes = _quantizer.encode(V, _workerCount);
+
+            // The zero vector value is computed exactly.
+            double zeroVecValue = 0.0;
+            for (Eigen::Index i = 0; i < V.rows(); i++)
+                zeroVecValue += V.row(i).squaredNorm();
+            _zeroVecValue = zeroVecValue / static_cast<double>(_n);
+
+            // Report memory savings and the reconstruction error.
+            _report.uncompressedMemory = V.size() * sizeof(float);
+            _report.compressedMemory = _codes.size() * sizeof(uint8_t) + _quantizer.codebookMemory();
+            double squaredError = 0.0;
+            for (Eigen::Index i = 0; i < V.rows(); i++)
+                squaredError += (_quantizer.decode(_codes, _n, i) - V.row(i).transpose()).squaredNorm();
+            _report.meanSquaredError = squaredError / static_cast<double>(_n);
+
+            // Measure the error w.r.t. the exact float32 function.
+            std::mt19937_64 generator(seed + 1);
+            const ApproximationError error = validateApproximation(V, [this](const MatrixX<double>& S) { return operator()(S); }, validationSets, generator, _workerCount);
+            _report.maxRelativeError = error.maxRelativeError;
+            _report.meanRelativeError = error.meanRelativeError;
+            _report.validationSets = error.validationSets;
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            if (S.cols() != _quantizer.dim())
+                throw std::runtime_error("ProductQuantizedExemplarClusteringSubmodularFunction::operator(): The dimensionality of S does not match the ground set ("
+                                         + std::to_string(S.cols()) + " vs. " + std::to_string(_quantizer.dim()) + ").");
+
+            // Add zero vector to data copy.
+            MatrixX<float> S_copy(S.rows() + 1, S.cols());
+            S_copy.topRows(S.rows()) = S.cast<float>();
+            S_copy.row(S.rows()).setZero();
+
+            return _zeroVecValue - L(S_copy);
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The (approximate) submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const ProductQuantizedExemplarClusteringSubmodularFunction*) (this))->operator()(S);
+        };
+
+        /**
+         * Returns memory savings and the error observed w.r.t. the exact float32 function during construction.
+         * @return As stated above.
+         */
+        const QuantizationReport& getReport() const {
+            return _report;
+        };
+
+    private:
+        // Number of ground set points, which are processed at once. The per-block distance buffer is small enough to stay in L1 cache.
+        static constexpr unsigned long BlockSize = 1024;
+
+        ProductQuantizer _quantizer;
+        std::vector<uint8_t> _codes;
+        unsigned long _n;
+        double _zeroVecValue;
+        QuantizationReport _report;
+
+        /**
+         * Calculates the L function using asymmetric distance lookups.
+         *
+         * @param S_inner Set of data to calculate the L function for.
+         * @return L function value.
+         */
+        double L(const MatrixX<float>& S_inner) const {
+            const unsigned int m = _quantizer.subspaces();
+
+            // Compute the lookup tables once per exemplar.
+            std::vector<float> tables(S_inner.rows() * m * ProductQuantizer::MaxCentroids);
+            for (Eigen::Index j = 0; j < S_inner.rows(); j++)
+                _quantizer.computeTable(S_inner.row(j).transpose(), tables.data() + j * m * ProductQuantizer::MaxCentroids);
+
+            const unsigned long blockCount = (_n + BlockSize - 1) / BlockSize;
+            std::vector<float> accuArray(_n);
+
+#pragma omp parallel for num_threads(_workerCount) schedule(static)
+            for (unsigned long b = 0; b < blockCount; b++) {
+                const unsigned long begin = b * BlockSize;
+                const unsigned long len = std::min(BlockSize, _n - begin);
+                float* minDistances = accuArray.data() + begin;
+                float distances[BlockSize];
+                std::fill(minDistances, minDistances + len, std::numeric_limits<float>::max());
+
+                for (Eigen::Index j = 0; j < S_inner.rows(); j++) {
+                    const float* table = tables.data() + j * m * ProductQuantizer::MaxCentroids;
+                    std::fill(distances, distances + len, 0.0f);
+
+                    // Accumulate the table entries subspace by subspace, which streams through the codes contiguously.
+                    for (unsigned int k = 0; k < m; k++) {
+                        const uint8_t* codes = _codes.data() + static_cast<size_t>(k) * _n + begin;
+                        const float* subTable = table + k * ProductQuantizer::MaxCentroids;
+#pragma omp simd
+                        for (unsigned long i = 0; i < len; i++)
+                            distances[i] += subTable[codes[i]];
+                    }
+
+#pragma omp simd
+                    for (unsigned long i = 0; i < len; i++)
+                        minDistances[i] = std::min(minDistances[i], distances[i]);
+                }
+            }
+
+            return reduceSum(accuArray.data(), _n, _reductionMode, _workerCount, _deterministic) / static_cast<double>(_n);
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_PQ
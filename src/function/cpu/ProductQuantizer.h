@@ -0,0 +1,192 @@
+#ifndef EXEMCL_PRODUCTQUANTIZER_H
+#define EXEMCL_PRODUCTQUANTIZER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <src/io/DataTypes.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * A product quantizer splits the \f$d\f$ dimensions of a vector into \f$m\f$ disjoint subspaces and quantizes every subspace independently with a codebook of up to 256
+     * centroids, which have been learned by k-means. Hence, every vector is represented by an \f$m\f$-byte code.
+     *
+     * Squared distances between an unquantized query \f$s\f$ and a quantized vector \f$v\f$ are approximated asymmetrically, i.e.
+     * \f$\|s - v\|^2 \approx \sum_{j=1}^m T_s[j][\text{code}_j(v)]\f$, where \f$T_s[j][c] = \|s_j - c_{j,c}\|^2\f$ is a lookup table, which has to be computed once per query.
+     */
+    class ProductQuantizer {
+    public:
+        static constexpr unsigned int MaxCentroids = 256;
+
+        /**
+         * Trains a product quantizer on a data set.
+         *
+         * @param X Training data with shape `[n, d]`.
+         * @param subspaces The number of subspaces \f$m\f$ (i.e. bytes per code).
+         * @param iterations The number of k-means iterations per subspace.
+         * @param trainingSize The maximum number of rows of `X`, which are sampled for training.
+         * @param seed Seed for the random number generator.
+         * @param workerCount The number of workers to employ.
+         */
+        ProductQuantizer(const MatrixX<float>& X, unsigned int subspaces, unsigned int iterations = 25, unsigned long trainingSize = 65536, unsigned long seed = 0,
+                         unsigned int workerCount = 1) {
+            if (subspaces == 0 || subspaces > X.cols())
+                throw std::runtime_error("ProductQuantizer: The number of subspaces needs to be within [1, " + std::to_string(X.cols()) + "], but is "
+                                         + std::to_string(subspaces) + ".");
+            if (X.rows() == 0)
+                throw std::runtime_error("ProductQuantizer: Cannot train a product quantizer on an empty data set.");
+
+            // Distribute the dimensions evenly across all subspaces.
+            _dim = X.cols();
+            for (unsigned int j = 0; j <= subspaces; j++)
+                _offsets.push_back(static_cast<unsigned int>((static_cast<unsigned long>(j) * _dim) / subspaces));
+            _centroidCount = static_cast<unsigned int>(std::min<Eigen::Index>(MaxCentroids, X.rows()));
+
+            // Sample the training set.
+            std::mt19937_64 generator(seed);
+            std::vector<Eigen::Index> trainingRows(X.rows());
+            std::iota(trainingRows.begin(), trainingRows.end(), 0);
+            if (trainingRows.size() > trainingSize) {
+                std::shuffle(trainingRows.begin(), trainingRows.end(), generator);
+                trainingRows.resize(trainingSize);
+            }
+
+            // Train a codebook per subspace.
+            _codebooks.resize(subspaces);
+            for (unsigned int j = 0; j < subspaces; j++) {
+                MatrixX<float> XSub(trainingRows.size(), subspaceDim(j));
+                for (unsigned long i = 0; i < trainingRows.size(); i++)
+                    XSub.row(i) = X.row(trainingRows[i]).segment(_offsets[j], subspaceDim(j));
+                _codebooks[j] = kMeans(XSub, iterations, generator, workerCount);
+            }
+        };
+
+        /**
+         * Encodes the rows of `X`. The codes are stored subspace-major, i.e. the code of row `i` for subspace `j` is located at `codes[j * X.rows() + i]`, such that
+         * distance computations stream contiguously through the codes of a subspace.
+         *
+         * @param X Data with shape `[n, d]`.
+         * @param workerCount The number of workers to employ.
+         * @return The codes.
+         */
+        std::vector<uint8_t> encode(const MatrixX<float>& X, unsigned int workerCount = 1) const {
+            std::vector<uint8_t> codes(static_cast<size_t>(X.rows()) * subspaces());
+            for (unsigned int j = 0; j < subspaces(); j++) {
+                const auto& codebook = _codebooks[j];
+#pragma omp parallel for num_threads(workerCount)
+                for (Eigen::Index i = 0; i < X.rows(); i++) {
+                    Eigen::Index nearest;
+                    (codebook.rowwise() - X.row(i).segment(_offsets[j], subspaceDim(j))).rowwise().squaredNorm().minCoeff(&nearest);
+                    codes[static_cast<size_t>(j) * X.rows() + i] = static_cast<uint8_t>(nearest);
+                }
+            }
+            return codes;
+        };
+
+        /**
+         * Computes the asymmetric distance lookup table of a query vector.
+         *
+         * @param s The query vector with `d` elements.
+         * @param table Output buffer with `subspaces() * MaxCentroids` elements. Entry `j * MaxCentroids + c` holds the squared distance between the `j`-th subspace of `s`
+         * and centroid `c` of this subspace.
+         */
+        template<typename Derived>
+        void computeTable(const Eigen::MatrixBase<Derived>& s, float* table) const {
+            for (unsigned int j = 0; j < subspaces(); j++) {
+                const auto& codebook = _codebooks[j];
+                for (unsigned int c = 0; c < _centroidCount; c++)
+                    table[j * MaxCentroids + c] = (codebook.row(c) - s.segment(_offsets[j], subspaceDim(j)).transpose()).squaredNorm();
+            }
+        };
+
+        /**
+         * Reconstructs a vector from its code.
+         *
+         * @param codes The codes created by `encode`.
+         * @param n The number of encoded rows.
+         * @param i The row to reconstruct.
+         * @return The reconstructed vector.
+         */
+        VectorX<float> decode(const std::vector<uint8_t>& codes, Eigen::Index n, Eigen::Index i) const {
+            VectorX<float> x(_dim);
+            for (unsigned int j = 0; j < subspaces(); j++)
+                x.segment(_offsets[j], subspaceDim(j)) = _codebooks[j].row(codes[static_cast<size_t>(j) * n + i]).transpose();
+            return x;
+        };
+
+        /**
+         * Returns the number of subspaces (i.e. bytes per code).
+         * @return As stated above.
+         */
+        unsigned int subspaces() const {
+            return static_cast<unsigned int>(_codebooks.size());
+        };
+
+        /**
+         * Returns the dimensionality of the quantized vectors.
+         * @return As stated above.
+         */
+        unsigned int dim() const {
+            return _dim;
+        };
+
+        /**
+         * Returns the memory occupied by the codebooks (in bytes).
+         * @return As stated above.
+         */
+        size_t codebookMemory() const {
+            return static_cast<size_t>(_centroidCount) * _dim * sizeof(float);
+        };
+
+    private:
+        unsigned int _dim;
+        unsigned int _centroidCount;
+        std::vector<unsigned int> _offsets;
+        std::vector<MatrixX<float>> _codebooks;
+
+        unsigned int subspaceDim(unsigned int j) const {
+            return _offsets[j + 1] - _offsets[j];
+        };
+
+        /**
+         * Runs Lloyd's algorithm on `X`, initialized with distinct random rows.
+         */
+        MatrixX<float> kMeans(const MatrixX<float>& X, unsigned int iterations, std::mt19937_64& generator, unsigned int workerCount) const {
+            std::vector<Eigen::Index> rows(X.rows());
+            std::iota(rows.begin(), rows.end(), 0);
+            std::shuffle(rows.begin(), rows.end(), generator);
+
+            MatrixX<float> centroids(_centroidCount, X.cols());
+            for (unsigned int c = 0; c < _centroidCount; c++)
+                centroids.row(c) = X.row(rows[c]);
+
+            std::vector<unsigned int> assignment(X.rows());
+            for (unsigned int it = 0; it < iterations; it++) {
+                // Assignment step.
+#pragma omp parallel for num_threads(workerCount)
+                for (Eigen::Index i = 0; i < X.rows(); i++) {
+                    Eigen::Index nearest;
+                    (centroids.rowwise() - X.row(i)).rowwise().squaredNorm().minCoeff(&nearest);
+                    assignment[i] = static_cast<unsigned int>(nearest);
+                }
+
+                // Update step. Empty clusters keep their previous centroid.
+                MatrixX<double> sums = MatrixX<double>::Zero(_centroidCount, X.cols());
+                std::vector<unsigned long> counts(_centroidCount, 0);
+                for (Eigen::Index i = 0; i < X.rows(); i++) {
+                    sums.row(assignment[i]) += X.row(i).cast<double>();
+                    counts[assignment[i]]++;
+                }
+                for (unsigned int c = 0; c < _centroidCount; c++)
+                    if (counts[c] > 0)
+                        centroids.row(c) = (sums.row(c) / static_cast<double>(counts[c])).cast<float>();
+            }
+
+            return centroids;
+        };
+    };
+}
+
+#endif // EXEMCL_PRODUCTQUANTIZER_H
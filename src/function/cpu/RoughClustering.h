@@ -0,0 +1,56 @@
+#ifndef EXEMCL_FUNCTION_CPU_ROUGHCLUSTERING
+#define EXEMCL_FUNCTION_CPU_ROUGHCLUSTERING
+
+#include <algorithm>
+#include <random>
+#include <src/io/DataTypes.h>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * Chooses `k` centers by \f$D^2\f$ sampling (i.e. k-means++ seeding) and assigns every point to its closest center.
+     *
+     * @param V The ground set V.
+     * @param k The number of centers.
+     * @param generator The random number generator.
+     * @param assignment Output vector with `V.rows()` entries, which receives the index of the closest center of every point.
+     * @param squaredDistances Output vector with `V.rows()` entries, which receives the squared Euclidean distance of every point to its closest center.
+     * @param workerCount The number of threads to employ.
+     */
+    template<typename HostDataType>
+    void roughClustering(const MatrixX<HostDataType>& V, unsigned int k, std::mt19937_64& generator, std::vector<unsigned int>& assignment,
+                         std::vector<double>& squaredDistances, unsigned int workerCount) {
+        const unsigned long n = V.rows();
+        std::uniform_int_distribution<unsigned long> firstCenter(0, n - 1);
+        VectorX<HostDataType> center = V.row(firstCenter(generator));
+        std::fill(assignment.begin(), assignment.end(), 0);
+
+#pragma omp parallel for num_threads(workerCount)
+        for (unsigned long i = 0; i < n; i++)
+            squaredDistances[i] = (V.row(i).transpose() - center).squaredNorm();
+
+        for (unsigned int c = 1; c < k; c++) {
+            // Sample the next center proportionally to the squared distance (or uniformly, if all points coincide with a center).
+            double totalCost = 0.0;
+            for (double d : squaredDistances)
+                totalCost += d;
+            unsigned long next = firstCenter(generator);
+            if (totalCost > 0.0) {
+                std::discrete_distribution<unsigned long> distribution(squaredDistances.begin(), squaredDistances.end());
+                next = distribution(generator);
+            }
+            center = V.row(next);
+
+#pragma omp parallel for num_threads(workerCount)
+            for (unsigned long i = 0; i < n; i++) {
+                double distance = (V.row(i).transpose() - center).squaredNorm();
+                if (distance < squaredDistances[i]) {
+                    squaredDistances[i] = distance;
+                    assignment[i] = c;
+                }
+            }
+        }
+    }
+}
+
+#endif // EXEMCL_FUNCTION_CPU_ROUGHCLUSTERING
@@ -0,0 +1,171 @@
+#ifndef EXEMCL_FUNCTION_CPU_SHAREDMEMORYGROUNDSET
+#define EXEMCL_FUNCTION_CPU_SHAREDMEMORYGROUNDSET
+
+#include <src/function/cpu/GroundSet.h>
+#include <src/io/FunctionArtifact.h>
+#include <string>
+#include <sys/mman.h>
+
+namespace exemcl::cpu {
+    /**
+     * Places a prepared ground set (see `GroundSet`) into a POSIX shared memory object, such that other processes on the same host (e.g. the workers of a Python
+     * `multiprocessing.Pool`) attach to it by name without any copy. The object uses the layout of function artifacts (see `FunctionArtifactHeader`), i.e. the points
+     * are stored page-aligned after the header, the weights and the parameters of the dissimilarity, which has prepared them.
+     *
+     * An instance owns the shared memory object and removes its name on destruction. Processes, which have attached before, keep their mapping, whereas later attempts to
+     * attach fail.
+     */
+    template<typename HostDataType = float>
+    class SharedMemoryGroundSet {
+    public:
+        /**
+         * Creates the shared memory object and copies the ground set into it.
+         *
+         * @param groundSet The ground set to publish.
+         * @param name The name of the shared memory object (starting with a slash, e.g. `/exemcl_1234`), which must not exist yet.
+         */
+        SharedMemoryGroundSet(const GroundSet<HostDataType>& groundSet, const std::string& name) : _name(name) {
+            auto V = groundSet.matrix();
+            const VectorX<HostDataType>& weights = groundSet.getWeights();
+            const VectorX<double>& parameters = groundSet.getDissimilarityParameters();
+            FunctionArtifactHeader header = FunctionArtifactHeader::create(sizeof(HostDataType), groundSet.getDissimilarity());
+            header.zeroVecValue = groundSet.getZeroVecValue();
+            header.totalWeight = groundSet.getTotalWeight();
+            if (weights.size() > 0)
+                header.flags |= FunctionArtifactHeader::Weighted;
+            std::vector<std::tuple<const void*, uint64_t, uint64_t>> arrays(static_cast<unsigned int>(ArtifactSection::Count), {nullptr, 0, 0});
+            arrays[static_cast<unsigned int>(ArtifactSection::Weights)] = {weights.data(), weights.size(), 1};
+            arrays[static_cast<unsigned int>(ArtifactSection::DissimilarityParameters)] = {parameters.data(), parameters.size(), 1};
+            arrays[static_cast<unsigned int>(ArtifactSection::GroundSet)] = {V.data(), V.rows(), V.cols()};
+            const uint64_t size = std::max<uint64_t>(layoutFunctionArtifact(header, arrays), sizeof(header));
+
+            int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0)
+                throw std::runtime_error("SharedMemoryGroundSet::SharedMemoryGroundSet: Unable to create the shared memory object '" + name + "' (" + std::strerror(errno)
+                                         + ").");
+            void* base = ftruncate(fd, size) == 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+            const std::string reason = std::strerror(errno);
+            close(fd);
+            if (base == MAP_FAILED) {
+                shm_unlink(name.c_str());
+                throw std::runtime_error("SharedMemoryGroundSet::SharedMemoryGroundSet: Unable to allocate " + std::to_string(size) + " byte of shared memory for '" + name
+                                         + "' (" + reason + ").");
+            }
+
+            char* data = static_cast<char*>(base);
+            std::memcpy(data, &header, sizeof(header));
+            for (unsigned int k = 0; k < arrays.size(); k++)
+                if (header.sections[k][1] * header.sections[k][2] > 0)
+                    std::memcpy(data + header.sections[k][0], std::get<0>(arrays[k]),
+                                header.sections[k][1] * header.sections[k][2] * header.scalarSizeOf(static_cast<ArtifactSection>(k)));
+            munmap(base, size);
+
+            try {
+                _groundSet = attach(name);
+            } catch (...) {
+                shm_unlink(name.c_str());
+                throw;
+            }
+        };
+
+        SharedMemoryGroundSet(const SharedMemoryGroundSet&) = delete;
+        SharedMemoryGroundSet& operator=(const SharedMemoryGroundSet&) = delete;
+
+        /**
+         * Removes the name of the shared memory object. The memory is released, once all processes have released their mappings.
+         */
+        ~SharedMemoryGroundSet() {
+            shm_unlink(_name.c_str());
+        };
+
+        /**
+         * Returns the name of the shared memory object.
+         * @return As stated above.
+         */
+        const std::string& getName() const {
+            return _name;
+        };
+
+        /**
+         * Returns the ground set, which is backed by the shared memory object (rather than by the published ground set).
+         * @return As stated above.
+         */
+        const std::shared_ptr<const GroundSet<HostDataType>>& getGroundSet() const {
+            return _groundSet;
+        };
+
+        /**
+         * Attaches to a shared memory object, which has been created by another instance (possibly within another process). The points are mapped read-only, hence they
+         * are not copied. Only the (optional) weights and the parameters of the dissimilarity are read into process memory.
+         *
+         * @param name The name of the shared memory object.
+         * @return The ground set, which is backed by the shared memory object.
+         */
+        static std::shared_ptr<const GroundSet<HostDataType>> attach(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                throw std::runtime_error("SharedMemoryGroundSet::attach: Unable to open the shared memory object '" + name + "' (" + std::strerror(errno) + ").");
+            FunctionArtifactHeader header {};
+            VectorX<HostDataType> weights;
+            VectorX<double> parameters;
+            try {
+                struct stat status {};
+                fstat(fd, &status);
+                if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+                    throw std::runtime_error("SharedMemoryGroundSet::attach: '" + name + "' does not hold a ground set.");
+                validateFunctionArtifactHeader(header, status.st_size, name);
+                if (header.scalarSize != sizeof(HostDataType))
+                    throw std::runtime_error("SharedMemoryGroundSet::attach: '" + name + "' holds scalars of " + std::to_string(header.scalarSize) + " byte, but "
+                                             + std::to_string(sizeof(HostDataType)) + " byte are required.");
+
+                if (header.has(ArtifactSection::Weights)) {
+                    const uint64_t* section = header.section(ArtifactSection::Weights);
+                    weights.resize(section[1]);
+                    const ssize_t length = section[1] * sizeof(HostDataType);
+                    if (pread(fd, weights.data(), length, section[0]) != length)
+                        throw std::runtime_error("SharedMemoryGroundSet::attach: Unable to read the weights of '" + name + "'.");
+                }
+                if (header.has(ArtifactSection::DissimilarityParameters)) {
+                    const uint64_t* section = header.section(ArtifactSection::DissimilarityParameters);
+                    parameters.resize(section[1]);
+                    const ssize_t length = section[1] * sizeof(double);
+                    if (pread(fd, parameters.data(), length, section[0]) != length)
+                        throw std::runtime_error("SharedMemoryGroundSet::attach: Unable to read the dissimilarity parameters of '" + name + "'.");
+                }
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+            close(fd);
+
+            const uint64_t* section = header.section(ArtifactSection::GroundSet);
+            auto mapping = MappedGroundSet<HostDataType>::fromSharedMemory(name, section[2], section[0], section[1]);
+            return GroundSet<HostDataType>::restore(MatrixX<HostDataType>(), std::move(mapping), std::move(weights), header.totalWeight, header.zeroVecValue,
+                                                    header.dissimilarity, std::move(parameters));
+        };
+
+        /**
+         * Reads the scalar size of a shared memory object, e.g. to choose the type, which is passed to `attach`.
+         *
+         * @param name The name of the shared memory object.
+         * @return The size of a scalar (in bytes).
+         */
+        static unsigned int scalarSize(const std::string& name) {
+            int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                throw std::runtime_error("SharedMemoryGroundSet::scalarSize: Unable to open the shared memory object '" + name + "' (" + std::strerror(errno) + ").");
+            FunctionArtifactHeader header {};
+            const bool complete = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+            close(fd);
+            if (!complete || std::memcmp(header.magic, FunctionArtifactHeader::Magic, sizeof(header.magic)) != 0)
+                throw std::runtime_error("SharedMemoryGroundSet::scalarSize: '" + name + "' does not hold a ground set.");
+            return header.scalarSize;
+        };
+
+    private:
+        std::string _name;
+        std::shared_ptr<const GroundSet<HostDataType>> _groundSet;
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_SHAREDMEMORYGROUNDSET
@@ -0,0 +1,420 @@
+#ifndef EXEMCL_FUNCTION_CPU_STREAMING
+#define EXEMCL_FUNCTION_CPU_STREAMING
+
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/DistanceKernels.h>
+#include <src/io/MappedGroundSet.h>
+#include <thread>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * This class provides an out-of-core CPU implementation of the submodular function of exemplar-based clustering for ground sets, which do not fit into memory. V is read
+     * from a `.npy` or a raw (little-endian, row-major) binary file in chunks.
+     *
+     * Every evaluation is a single sequential pass over the file. A background reader thread fills one of two chunk buffers, whilst the compute threads determine the minimal
+     * dissimilarities of the other chunk (see `kernels::dispatchMinDissimilarities`) and reduce them into the running sums of L. Batched calls (multiple sets, marginal
+     * gains of multiple sets or multiple candidates) are evaluated within the same pass, hence every chunk is read once per batch. The chunk size follows from the memory
+     * budget (see `setMemoryLimit`), which covers both chunk buffers and the per-point minima.
+     *
+     * \f$L({0})\f$ is computed during the first pass.
+     */
+    template<typename HostDataType = float, typename Dissimilarity = SquaredEuclidean>
+    class StreamingExemplarClusteringSubmodularFunction : public SubmodularFunction {
+    public:
+        using SubmodularFunction::operator();
+
+        /**
+         * The default memory budget (256 MiB).
+         */
+        static constexpr long DefaultMemoryLimit = 256l << 20;
+
+        /**
+         * Constructs the streaming exemplar clustering submodular function. Only the header of the file is read.
+         *
+         * @param path Path to a `.npy` file (whose type matches `HostDataType`) or to a raw binary file.
+         * @param dim The dimensionality of the ground set (required for raw files).
+         * @param memoryLimit The memory budget (in byte) for the chunk buffers.
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare every chunk and all evaluated sets.
+         */
+        explicit StreamingExemplarClusteringSubmodularFunction(const std::string& path, unsigned long dim = 0, long memoryLimit = DefaultMemoryLimit, int workerCount = -1,
+                                                               const Dissimilarity& dissimilarity = Dissimilarity()) :
+            SubmodularFunction(workerCount),
+            _path(path), _dissimilarity(dissimilarity) {
+            const bool npy = path.size() >= 4 && path.compare(path.size() - 4, 4, ".npy") == 0;
+            if (npy) {
+                NpyHeader header = readNpyHeader(path);
+                const std::string expected = std::is_same<HostDataType, float>::value ? "<f4" : "<f8";
+                if (header.descr != expected)
+                    throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::StreamingExemplarClusteringSubmodularFunction: The type of '" + path + "' ("
+                                             + header.descr + ") does not match the expected type (" + expected + ").");
+                _rows = header.rows;
+                _cols = header.cols;
+                _offset = header.dataOffset;
+            } else {
+                if (dim == 0)
+                    throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::StreamingExemplarClusteringSubmodularFunction: Raw files require the dimensionality.");
+                _cols = dim;
+                _offset = 0;
+            }
+
+            _fd = open(path.c_str(), O_RDONLY);
+            if (_fd < 0)
+                throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::StreamingExemplarClusteringSubmodularFunction: Unable to open '" + path + "'.");
+            struct stat status {};
+            fstat(_fd, &status);
+            if (!npy)
+                _rows = status.st_size / (_cols * sizeof(HostDataType));
+            if (static_cast<unsigned long>(status.st_size) < _offset + _rows * _cols * sizeof(HostDataType)) {
+                close(_fd);
+                throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::StreamingExemplarClusteringSubmodularFunction: '" + path
+                                         + "' is smaller than its header suggests.");
+            }
+            posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+            setMemoryLimit(memoryLimit);
+        };
+
+        StreamingExemplarClusteringSubmodularFunction(const StreamingExemplarClusteringSubmodularFunction&) = delete;
+        StreamingExemplarClusteringSubmodularFunction& operator=(const StreamingExemplarClusteringSubmodularFunction&) = delete;
+
+        /**
+         * Closes the file.
+         */
+        ~StreamingExemplarClusteringSubmodularFunction() override {
+            close(_fd);
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) const override {
+            return evaluate({S})[0];
+        };
+
+        /**
+         * Evaluates the exemplar cluster-submodular function.
+         *
+         * @param S The set to evaluate.
+         * @return The submodular function value.
+         */
+        double operator()(const MatrixX<double>& S) override {
+            return ((const StreamingExemplarClusteringSubmodularFunction*) (this))->operator()(S);
+        };
+
+        /**
+         * Calculates the marginal gain w.r.t. \f$S\f$ and a marginal element \f$e\f$ within a single pass.
+         *
+         * @param S Set of vectors, to calculate the submodular function for.
+         * @param elem A marginal element.
+         * @return The marginal gain \f$f(S \cup \{e\}) - f(S)\f$.
+         */
+        double operator()(const MatrixX<double>& S, VectorXRef<double> elem) const override {
+            return gains(S, {elem})[0];
+        };
+
+        /**
+         * Calculates the submodular function for more than one set within a single pass.
+         *
+         * @param S_multi A set of sets \f$S = \left\{S_1, ..., S_n\right\}\f$.
+         * @return A set of utility values \f$\left\{f(S_1), ..., f(S_n)\right\}\f$.
+         */
+        std::vector<double> operator()(const std::vector<MatrixX<double>>& S_multi) const override {
+            return evaluate(S_multi);
+        };
+
+        /**
+         * Calculates the marginal gain for a multi set and a marginal element within a single pass.
+         *
+         * @param S_multi A set of sets \f$S = \left\{S_1, ..., S_n\right\}\f$.
+         * @param elem A marginal element \f$e\f$.
+         * @return A set of marginal gain values \f$\Delta_f(e | S_1), ..., \Delta_f(e | S_n)\f$.
+         */
+        std::vector<double> operator()(const std::vector<MatrixX<double>>& S_multi, VectorXRef<double> elem) const override {
+            std::vector<MatrixX<double>> sets = S_multi;
+            for (auto& S_elem : S_multi) {
+                if (S_elem.cols() != elem.size())
+                    throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::operator(): The number of columns in matrix `S` and the number of elements in vector "
+                                             "`elem` do not match (" + std::to_string(S_elem.cols()) + " vs. " + std::to_string(elem.size()) + ").");
+                sets.push_back(S_elem);
+                sets.back().conservativeResize(S_elem.rows() + 1, Eigen::NoChange_t());
+                sets.back().row(S_elem.rows()) = elem.transpose();
+            }
+
+            std::vector<double> values = evaluate(sets);
+            std::vector<double> marginalGains(S_multi.size());
+            for (unsigned long i = 0; i < S_multi.size(); i++)
+                marginalGains[i] = values[S_multi.size() + i] - values[i];
+            return marginalGains;
+        };
+
+        /**
+         * Calculates the marginal gain for a single set \f$S\f$ and a set of marginal vectors within a single pass. The minimal dissimilarity w.r.t. \f$S\f$ is computed
+         * once per point and shared by all candidates.
+         *
+         * @param S Set of vectors, which should be used to calculate the marginal value in conjunction with `elems`.
+         * @param elems A set of marginal vectors \f$\left\{e_1, ..., e_n \right\}\f$.
+         * @return A set of marginal gain values \f$\Delta_f(e_1 | S), ..., \Delta_f(e_n | S)\f$.
+         */
+        std::vector<double> operator()(const MatrixX<double>& S, std::vector<VectorXRef<double>> elems) const override {
+            return gains(S, elems);
+        };
+
+        /**
+         * Updates the memory budget, which determines the number of points per chunk.
+         * @param memoryLimit Memory limit (in byte).
+         */
+        void setMemoryLimit(long memoryLimit) override {
+            // Two chunk buffers, the per-point minima and the per-point dissimilarities to a candidate.
+            const long bytesPerRow = 2 * static_cast<long>(_cols * sizeof(HostDataType)) + 2 * static_cast<long>(sizeof(HostDataType));
+            if (memoryLimit < bytesPerRow)
+                throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::setMemoryLimit: The memory limit needs to cover at least one point per chunk ("
+                                         + std::to_string(bytesPerRow) + " byte).");
+            // A running pass sizes its buffers by _chunkRows, hence the update waits for it.
+            std::lock_guard<std::mutex> passLock(_passMutex);
+            _memoryLimit = memoryLimit;
+            _chunkRows = std::max<unsigned long>(std::min<unsigned long>(memoryLimit / bytesPerRow, _rows), 1);
+        };
+
+        /**
+         * Returns the memory budget.
+         * @return As stated above.
+         */
+        long getMemoryLimit() const {
+            std::lock_guard<std::mutex> passLock(_passMutex);
+            return _memoryLimit;
+        };
+
+        /**
+         * Returns the number of points, which are read per chunk.
+         * @return As stated above.
+         */
+        unsigned long getChunkRows() const {
+            std::lock_guard<std::mutex> passLock(_passMutex);
+            return _chunkRows;
+        };
+
+        /**
+         * Returns the number of points in the ground set.
+         * @return As stated above.
+         */
+        unsigned long rows() const {
+            return _rows;
+        };
+
+        /**
+         * Returns the dimensionality of the ground set.
+         * @return As stated above.
+         */
+        unsigned long cols() const {
+            return _cols;
+        };
+
+    private:
+        std::string _path;
+        int _fd = -1;
+        unsigned long _rows = 0;
+        unsigned long _cols = 0;
+        unsigned long _offset = 0;
+        long _memoryLimit = 0;
+        unsigned long _chunkRows = 1;
+        Dissimilarity _dissimilarity;
+
+        // Passes are serialized, since concurrent passes would only compete for the disk. L({0}) is computed during the first pass.
+        mutable std::mutex _passMutex;
+        mutable std::optional<double> _zeroVecValue;
+
+        /**
+         * Casts and prepares a set and adds the zero vector.
+         */
+        MatrixX<HostDataType> prepareSet(const MatrixX<double>& S) const {
+            if (static_cast<unsigned long>(S.cols()) != _cols)
+                throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction: The dimensionality of `S` does not match the ground set (" + std::to_string(S.cols())
+                                         + " vs. " + std::to_string(_cols) + ").");
+            MatrixX<HostDataType> S_copy(S.rows() + 1, S.cols());
+            S_copy.topRows(S.rows()) = S.cast<HostDataType>();
+            auto S_prepared = S_copy.topRows(S.rows());
+            _dissimilarity.prepare(S_prepared);
+            S_copy.row(S.rows()).setZero();
+            return S_copy;
+        };
+
+        /**
+         * Evaluates f for a batch of sets within a single pass.
+         */
+        std::vector<double> evaluate(const std::vector<MatrixX<double>>& S_multi) const {
+            std::vector<MatrixX<HostDataType>> sets;
+            sets.reserve(S_multi.size() + 1);
+            for (auto& S : S_multi)
+                sets.push_back(prepareSet(S));
+
+            std::lock_guard<std::mutex> passLock(_passMutex);
+            const bool computeZero = !_zeroVecValue.has_value();
+            if (computeZero)
+                sets.push_back(MatrixX<HostDataType>::Zero(1, _cols));
+
+            std::vector<double> sums(sets.size(), 0.0);
+            VectorX<HostDataType> minDistances(_chunkRows);
+            stream([&](ConstMatrixXRef<HostDataType> chunk) {
+                for (unsigned long k = 0; k < sets.size(); k++) {
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(chunk, sets[k], minDistances.data(), _workerCount);
+                    sums[k] += reduceSum(minDistances.data(), chunk.rows(), _reductionMode, _workerCount, _deterministic);
+                }
+            });
+
+            const double n = static_cast<double>(std::max(_rows, 1ul));
+            if (computeZero) {
+                _zeroVecValue = sums.back() / n;
+                sets.pop_back();
+            }
+            std::vector<double> values(S_multi.size());
+            for (unsigned long k = 0; k < S_multi.size(); k++)
+                values[k] = *_zeroVecValue - sums[k] / n;
+            return values;
+        };
+
+        /**
+         * Evaluates the marginal gains of several candidates w.r.t. a single set within a single pass.
+         */
+        std::vector<double> gains(const MatrixX<double>& S, const std::vector<VectorXRef<double>>& elems) const {
+            MatrixX<HostDataType> S_prepared = prepareSet(S);
+            std::vector<MatrixX<HostDataType>> candidates(elems.size());
+            for (unsigned long k = 0; k < elems.size(); k++) {
+                if (elems[k].size() != static_cast<Eigen::Index>(_cols))
+                    throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction::operator(): The number of columns in matrix `S` and the number of elements in vector "
+                                             "`elem` do not match (" + std::to_string(_cols) + " vs. " + std::to_string(elems[k].size()) + ").");
+                candidates[k] = elems[k].transpose().template cast<HostDataType>();
+                _dissimilarity.prepare(candidates[k]);
+            }
+
+            std::lock_guard<std::mutex> passLock(_passMutex);
+            std::vector<double> sums(elems.size(), 0.0);
+            VectorX<HostDataType> curMin(_chunkRows), distances(_chunkRows);
+            stream([&](ConstMatrixXRef<HostDataType> chunk) {
+                const Eigen::Index rows = chunk.rows();
+                kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(chunk, S_prepared, curMin.data(), _workerCount);
+                for (unsigned long k = 0; k < elems.size(); k++) {
+                    kernels::dispatchMinDissimilarities<HostDataType, Dissimilarity>(chunk, candidates[k], distances.data(), _workerCount);
+                    distances.head(rows) = (curMin.head(rows) - distances.head(rows)).cwiseMax(HostDataType(0));
+                    sums[k] += reduceSum(distances.data(), rows, _reductionMode, _workerCount, _deterministic);
+                }
+            });
+
+            std::vector<double> gains(elems.size());
+            for (unsigned long k = 0; k < elems.size(); k++)
+                gains[k] = sums[k] / static_cast<double>(std::max(_rows, 1ul));
+            return gains;
+        };
+
+        /**
+         * Reads the ground set chunk by chunk and calls `visitor` for every (prepared) chunk. Whilst a chunk is visited, the next chunk is read by a background thread.
+         * Requires `_passMutex` to be held by the caller.
+         */
+        template<typename Visitor>
+        void stream(Visitor&& visitor) const {
+            const unsigned long chunkCount = (_rows + _chunkRows - 1) / _chunkRows;
+            const size_t rowBytes = _cols * sizeof(HostDataType);
+            std::array<MatrixX<HostDataType>, 2> buffers;
+            std::array<unsigned long, 2> filled = {0, 0};
+            std::array<bool, 2> ready = {false, false};
+            for (auto& buffer : buffers)
+                buffer.resize(std::min(_chunkRows, _rows), _cols);
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::exception_ptr readerError;
+            bool abort = false;
+
+            std::thread reader([&]() {
+                try {
+                    for (unsigned long c = 0; c < chunkCount; c++) {
+                        const unsigned long b = c % 2;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            condition.wait(lock, [&]() { return !ready[b] || abort; });
+                            if (abort)
+                                return;
+                        }
+
+                        const unsigned long rows = std::min(_chunkRows, _rows - c * _chunkRows);
+                        const off_t position = _offset + c * _chunkRows * rowBytes;
+                        readFully(reinterpret_cast<char*>(buffers[b].data()), rows * rowBytes, position);
+
+                        // Ask the kernel to fetch the following chunk, whilst the current chunk is processed.
+                        if (c + 1 < chunkCount)
+                            posix_fadvise(_fd, position + rows * rowBytes, std::min(_chunkRows, _rows - (c + 1) * _chunkRows) * rowBytes, POSIX_FADV_WILLNEED);
+
+                        std::lock_guard<std::mutex> lock(mutex);
+                        filled[b] = rows;
+                        ready[b] = true;
+                        condition.notify_all();
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    readerError = std::current_exception();
+                    condition.notify_all();
+                }
+            });
+
+            std::exception_ptr computeError;
+            for (unsigned long c = 0; c < chunkCount; c++) {
+                const unsigned long b = c % 2;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    condition.wait(lock, [&]() { return ready[b] || readerError; });
+                    if (readerError)
+                        break;
+                }
+
+                try {
+                    auto chunk = buffers[b].topRows(filled[b]);
+                    _dissimilarity.prepare(chunk);
+                    visitor(ConstMatrixXRef<HostDataType>(chunk));
+                } catch (...) {
+                    computeError = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                ready[b] = false;
+                abort = computeError != nullptr;
+                condition.notify_all();
+                if (computeError)
+                    break;
+            }
+
+            reader.join();
+            if (computeError)
+                std::rethrow_exception(computeError);
+            if (readerError)
+                std::rethrow_exception(readerError);
+        };
+
+        /**
+         * Reads `length` bytes at `position`, retrying on partial reads.
+         */
+        void readFully(char* buffer, size_t length, off_t position) const {
+            while (length > 0) {
+                ssize_t count = pread(_fd, buffer, length, position);
+                if (count < 0 && errno == EINTR)
+                    continue;
+                if (count <= 0)
+                    throw std::runtime_error("StreamingExemplarClusteringSubmodularFunction: Unable to read '" + _path + "' ("
+                                             + (count < 0 ? std::strerror(errno) : "unexpected end of file") + ").");
+                buffer += count;
+                length -= count;
+                position += count;
+            }
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_STREAMING
@@ -0,0 +1,90 @@
+#ifndef EXEMCL_FUNCTION_CPU_WEIGHTEDGROUNDSET
+#define EXEMCL_FUNCTION_CPU_WEIGHTEDGROUNDSET
+
+#include <cmath>
+#include <cstring>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace exemcl::cpu {
+    /**
+     * A ground set, in which every point \f$v\f$ carries a non-negative weight \f$w_v\f$. The exemplar clustering function then evaluates
+     * \f$L(S) = \frac{1}{\sum_v w_v} \sum_v w_v \min_{s \in S} d(v, s)\f$.
+     */
+    template<typename HostDataType = float>
+    struct WeightedGroundSet {
+        MatrixX<HostDataType> points; // The (unique) points, one per row.
+        VectorX<double> weights;      // The weight of every point.
+
+        /**
+         * Constructs an empty weighted ground set.
+         */
+        WeightedGroundSet() = default;
+
+        /**
+         * Constructs a weighted ground set and validates the weights.
+         *
+         * @param points The points, one per row.
+         * @param weights The non-negative weight of every point.
+         */
+        WeightedGroundSet(MatrixX<HostDataType> points, VectorX<double> weights) : points(std::move(points)), weights(std::move(weights)) {
+            if (this->weights.size() != this->points.rows())
+                throw std::runtime_error("WeightedGroundSet::WeightedGroundSet: The number of weights does not match the number of points (" + std::to_string(this->weights.size())
+                                         + " vs. " + std::to_string(this->points.rows()) + ").");
+            if ((this->weights.array() < 0.0).any() || (this->points.rows() > 0 && this->weights.sum() <= 0.0))
+                throw std::runtime_error("WeightedGroundSet::WeightedGroundSet: The weights must not be negative and need to have a positive sum.");
+        };
+
+        /**
+         * Collapses exact or near-exact duplicates of V into single, weighted points. Every row is hashed after rounding its coordinates to a grid with spacing `tolerance`
+         * (or bit-exactly, if `tolerance` is zero). All rows, which fall into the same grid cell, are represented by their first occurrence, whose weight equals the number
+         * of rows in that cell. Please note, that two rows closer than `tolerance` may still fall into neighboring cells and are kept separately in this case.
+         *
+         * @param V The ground set V.
+         * @param tolerance The grid spacing, which is used to detect near-exact duplicates (0 detects exact duplicates only).
+         * @return The weighted ground set of unique points.
+         */
+        static WeightedGroundSet collapseDuplicates(const MatrixX<HostDataType>& V, double tolerance = 0.0) {
+            if (tolerance < 0.0)
+                throw std::runtime_error("WeightedGroundSet::collapseDuplicates: The tolerance must not be negative.");
+
+            std::unordered_map<std::string, unsigned long> cells;
+            cells.reserve(V.rows());
+            std::vector<Eigen::Index> representatives;
+            std::vector<double> counts;
+            std::string key(V.cols() * sizeof(int64_t), '\0');
+
+            for (Eigen::Index i = 0; i < V.rows(); i++) {
+                for (Eigen::Index d = 0; d < V.cols(); d++) {
+                    int64_t cell = 0;
+                    if (tolerance > 0.0)
+                        cell = static_cast<int64_t>(std::floor(static_cast<double>(V(i, d)) / tolerance + 0.5));
+                    else {
+                        // Map +0 and -0 to the same cell, otherwise compare bit-exactly.
+                        HostDataType value = V(i, d) == HostDataType(0) ? HostDataType(0) : V(i, d);
+                        std::memcpy(&cell, &value, sizeof(HostDataType));
+                    }
+                    std::memcpy(&key[d * sizeof(int64_t)], &cell, sizeof(int64_t));
+                }
+
+                auto [it, inserted] = cells.try_emplace(key, representatives.size());
+                if (inserted) {
+                    representatives.push_back(i);
+                    counts.push_back(1.0);
+                } else
+                    counts[it->second] += 1.0;
+            }
+
+            MatrixX<HostDataType> points(representatives.size(), V.cols());
+            for (unsigned long k = 0; k < representatives.size(); k++)
+                points.row(k) = V.row(representatives[k]);
+
+            return WeightedGroundSet(std::move(points), Eigen::Map<VectorX<double>>(counts.data(), counts.size()));
+        };
+    };
+}
+
+#endif // EXEMCL_FUNCTION_CPU_WEIGHTEDGROUNDSET
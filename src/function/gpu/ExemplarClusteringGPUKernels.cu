@@ -1,7 +1,12 @@
 #ifndef EXEMCL_EXEMPLARCLUSTERINGGPUKERNELS_CU
 #define EXEMCL_EXEMPLARCLUSTERINGGPUKERNELS_CU
 
-template<typename DeviceDataType>
+#include <src/function/Dissimilarity.h>
+
+/**
+ * Computes the minimal dissimilarity (see `exemcl::SquaredEuclidean`) between every v and the vectors of every summary.
+ */
+template<typename DeviceDataType, typename Dissimilarity>
 __global__ void exemplarClusteringKernel(const DeviceDataType* vMatrix, const int nV, const DeviceDataType* summaryMatrix, const int maxS, const int* summarySizes,
                                          const int nS_multi, const int dim, DeviceDataType* resultMatrix) {
     // Create a variable, which represents the current v and S to work on.
@@ -31,12 +36,9 @@ __global__ void exemplarClusteringKernel(const DeviceDataType* vMatrix, const in
             // Iterate over all vectors in S.
             for (int i = 0; i < summarySizes[sJob]; i++) {
                 DeviceDataType distance = 0.0;
-                for (int d = 0; d < dim; d++) {
-                    if constexpr (std::is_same<DeviceDataType, float>::value)
-                        distance += powf(vShared[threadIdx.x * dim + d] - summaryMatrix[i * nS_multi + d * maxS * nS_multi + sJob], 2.0f);
-                    else
-                        distance += pow(vShared[threadIdx.x * dim + d] - summaryMatrix[i * nS_multi + d * maxS * nS_multi + sJob], 2.0);
-                }
+                for (int d = 0; d < dim; d++)
+                    distance = Dissimilarity::accumulate(distance, vShared[threadIdx.x * dim + d], summaryMatrix[i * nS_multi + d * maxS * nS_multi + sJob]);
+                distance = Dissimilarity::finalize(distance);
                 minDistance = minDistance > distance ? distance : minDistance;
             }
 
@@ -46,6 +48,10 @@ __global__ void exemplarClusteringKernel(const DeviceDataType* vMatrix, const in
     }
 }
 
+/**
+ * Computes the minimal dissimilarity between every v and the vectors of every summary in half precision. Two dimensions are processed at once using `__half2` arithmetic.
+ */
+template<typename Dissimilarity>
 __global__ void exemplarClusteringKernel(const __half* vMatrix, const int nV, const __half* summaryMatrix, const int maxS, const int* summarySizes, const int nS_multi,
                                          const int dim, float* resultMatrix) {
 #define V_ACCESS(dim_idx) vSharedHalf[threadIdx.x * dim + (dim_idx)]
@@ -75,22 +81,15 @@ __global__ void exemplarClusteringKernel(const __half* vMatrix, const int nV, co
             // Iterate over all vectors in S.
             for (int i = 0; i < summarySizes[sJob]; i++) {
                 __half2 distance2(0.0, 0.0);
-                int d = 0;
-                while (d < dim) {
+                for (int d = 0; d + 1 < dim; d += 2) {
                     __half2 vData(V_ACCESS(d), V_ACCESS(d + 1));
                     __half2 sData(SMAT_ACCESS(d), SMAT_ACCESS(d + 1));
-                    __half2 diffData = __hsub2(vData, sData);
-                    __half2 powData = __hmul2(diffData, diffData);
-                    distance2 += powData;
-
-                    // Increase `d`.
-                    d += 2;
+                    distance2 = Dissimilarity::accumulate(distance2, vData, sData);
                 }
                 __half distance = distance2.x + distance2.y;
-                if (dim % 2 == 1) {
-                    __half diff = V_ACCESS(dim - 1) - SMAT_ACCESS(dim - 1);
-                    distance += __hmul(diff, diff);
-                }
+                if (dim % 2 == 1)
+                    distance = Dissimilarity::accumulate(distance, V_ACCESS(dim - 1), SMAT_ACCESS(dim - 1));
+                distance = Dissimilarity::finalize(distance);
 
                 minDistance = minDistance > distance ? distance : minDistance;
 
@@ -101,4 +100,31 @@ __global__ void exemplarClusteringKernel(const __half* vMatrix, const int nV, co
     }
 }
 
+/**
+ * Sums up the result matrix for every summary using fp64 accumulators. Every block handles a single summary, whose values are first accumulated per thread and then
+ * combined by a tree reduction in shared memory. `blockDim.x` needs to be a power of two.
+ */
+template<typename ResultDataType>
+__global__ void compensatedReductionKernel(const ResultDataType* resultMatrix, const int nV, const int nS_multi, double* reductionVector) {
+    extern __shared__ double partialSums[];
+    int sJob = blockIdx.x;
+
+    // Accumulate a strided subset of the values in double precision.
+    double accu = 0.0;
+    for (long vJob = threadIdx.x; vJob < nV; vJob += blockDim.x)
+        accu += static_cast<double>(resultMatrix[vJob * (long) nS_multi + (long) sJob]);
+    partialSums[threadIdx.x] = accu;
+    __syncthreads();
+
+    // Combine the partial sums pairwise.
+    for (unsigned int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+        if (threadIdx.x < stride)
+            partialSums[threadIdx.x] += partialSums[threadIdx.x + stride];
+        __syncthreads();
+    }
+
+    if (threadIdx.x == 0)
+        reductionVector[sJob] = partialSums[0];
+}
+
 #endif // EXEMCL_EXEMPLARCLUSTERINGGPUKERNELS_CU
@@ -10,9 +10,10 @@
 
 namespace exemcl::gpu {
     /**
-     * This class provides a GPU implementation of the submodular function of Exemplar-based clustering.
+     * This class provides a GPU implementation of the submodular function of Exemplar-based clustering. The dissimilarity between points is given by a policy (see
+     * `SquaredEuclidean`), which defaults to the squared Euclidean distance.
      */
-    template<typename DeviceDataType = float, typename HostDataType = float>
+    template<typename DeviceDataType = float, typename HostDataType = float, typename Dissimilarity = SquaredEuclidean>
     class ExemplarClusteringSubmodularFunction : public SubmodularFunction {
     public:
         using SubmodularFunction::operator();
@@ -30,8 +31,14 @@ namespace exemcl::gpu {
          * Instantiates the submodular function of Exemplar-based clustering.
          * @param V The ground set to operate on.
          * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         * @param dissimilarity The dissimilarity policy, which is used to prepare V and all evaluated sets.
          */
-        explicit ExemplarClusteringSubmodularFunction(const exemcl::MatrixX<HostDataType, Eigen::ColMajor>& V, int workerCount = -1) {
+        explicit ExemplarClusteringSubmodularFunction(exemcl::MatrixX<HostDataType, Eigen::ColMajor> V, int workerCount = -1,
+                                                      const Dissimilarity& dissimilarity = Dissimilarity()) :
+            SubmodularFunction(workerCount), _dissimilarity(dissimilarity) {
+            // Prepare V once.
+            _dissimilarity.prepare(V);
+
             // Store V shape.
             _vShape[0] = V.rows();
             _vShape[1] = V.cols();
@@ -54,14 +61,12 @@ namespace exemcl::gpu {
 
             // Evaluate the zero vec value.
             auto* accuArray = new HostDataType[V.rows()];
+            const Eigen::Matrix<HostDataType, 1, Eigen::Dynamic> zeroVec = Eigen::Matrix<HostDataType, 1, Eigen::Dynamic>::Zero(V.cols());
 #pragma omp parallel for num_threads(_workerCount)
             for (unsigned int i = 0; i < V.rows(); i++)
-                accuArray[i] = (-1 * V.row(i)).squaredNorm();
+                accuArray[i] = Dissimilarity::evaluate(V.row(i), zeroVec);
 
-            _zeroVecValue = 0.0;
-#pragma omp simd reduction(+ : _zeroVecValue)
-            for (unsigned int i = 0; i < V.rows(); i++)
-                _zeroVecValue += accuArray[i];
+            _zeroVecValue = reduceSum(accuArray, V.rows(), ReductionMode::Compensated);
             delete[] accuArray;
             _zeroVecValue /= V.rows();
 
@@ -77,8 +82,10 @@ namespace exemcl::gpu {
         std::vector<double> operator()(const std::vector<MatrixX<double>>& S_multi) const override {
             auto S_multi_copy = std::make_unique<std::vector<MatrixX<HostDataType>>>();
             S_multi_copy->reserve(S_multi.size());
-            for (auto& S : S_multi)
+            for (auto& S : S_multi) {
                 S_multi_copy->push_back(S.cast<HostDataType>());
+                _dissimilarity.prepare(S_multi_copy->back());
+            }
 
             // Add the zero vector to all summaries.
             unsigned long maxS = 0;
@@ -156,6 +163,7 @@ namespace exemcl::gpu {
         double operator()(const MatrixX<double>& S) const override {
             if (S.rows() > 0) {
                 auto S_copy = std::make_unique<MatrixX<HostDataType>>(S.cast<HostDataType>());
+                _dissimilarity.prepare(*S_copy);
 
                 // Create the zero vector and add it to the summary to evaluate.
                 S_copy->conservativeResize(S_copy->rows() + 1, Eigen::NoChange_t());
@@ -203,8 +211,9 @@ namespace exemcl::gpu {
         };
 
     private:
-        HostDataType _zeroVecValue;
+        double _zeroVecValue;
         std::array<unsigned long, 2> _vShape;
+        Dissimilarity _dissimilarity;
 
         // CuBLAS
         cublasHandle_t _handle;
@@ -244,13 +253,36 @@ namespace exemcl::gpu {
 
             // Invoke kernel.
             if constexpr (std::is_same<DeviceDataType, __half>::value) {
-                exemplarClusteringKernel<<<kernelConf.gridDim, kernelConf.blockDim, kernelConf.sharedMemory>>>(_vMatrix, (int) _vShape[0], gpuSummaryMatrix, maxS, gpuSummarySizes,
-                                                                                                               (int) S_multi.size(), (int) _vShape[1], gpuResultMatrix);
+                exemplarClusteringKernel<Dissimilarity><<<kernelConf.gridDim, kernelConf.blockDim, kernelConf.sharedMemory>>>(
+                    _vMatrix, (int) _vShape[0], gpuSummaryMatrix, maxS, gpuSummarySizes, (int) S_multi.size(), (int) _vShape[1], gpuResultMatrix);
             } else {
-                exemplarClusteringKernel<DeviceDataType><<<kernelConf.gridDim, kernelConf.blockDim, kernelConf.sharedMemory>>>(
+                exemplarClusteringKernel<DeviceDataType, Dissimilarity><<<kernelConf.gridDim, kernelConf.blockDim, kernelConf.sharedMemory>>>(
                     _vMatrix, (int) _vShape[0], gpuSummaryMatrix, maxS, gpuSummarySizes, (int) S_multi.size(), (int) _vShape[1], gpuResultMatrix);
             }
 
+            // Release host data as long as we are waiting for the result matrix to arrive.
+            delete[] summarySizes;
+            delete summaryMatrix;
+
+            // Reduce the result matrix row-wise by sum.
+            std::vector<double> finalResultVector = _reductionMode == ReductionMode::Compensated ? reduceCompensated(gpuResultMatrix, S_multi.size())
+                                                                                                  : reduceNaive(gpuResultMatrix, S_multi.size());
+
+            // Release GPU data.
+            CUDA_CHECK_RETURN(cudaFree(gpuSummaryMatrix));
+            CUDA_CHECK_RETURN(cudaFree(gpuSummarySizes));
+            CUDA_CHECK_RETURN(cudaFree(gpuResultMatrix));
+
+            return finalResultVector;
+        };
+
+        /**
+         * Sums up the result matrix for every summary by a matrix-vector product with a one vector (using cuBLAS in the working precision).
+         * @param gpuResultMatrix The result matrix in GPU memory.
+         * @param summaryCount The number of summaries.
+         * @return The sum for every summary.
+         */
+        std::vector<double> reduceNaive(HostDataType* gpuResultMatrix, unsigned long summaryCount) const {
             // Copy auxiliary one vector to GPU as long as we are waiting for the result matrix to arrive.
             VectorX<HostDataType> oneVector = VectorX<HostDataType>::Ones(_vShape[0]);
             HostDataType* gpuOneVector;
@@ -259,7 +291,7 @@ namespace exemcl::gpu {
 
             // Allocate memory for the result of the row reduction by sum.
             HostDataType* gpuRowReductionVector;
-            CUDA_CHECK_RETURN(cudaMalloc((void**) &gpuRowReductionVector, S_multi.size() * sizeof(HostDataType)));
+            CUDA_CHECK_RETURN(cudaMalloc((void**) &gpuRowReductionVector, summaryCount * sizeof(HostDataType)));
 
             // Wait for the results to arrive.
             CUDA_CHECK_RETURN(cudaDeviceSynchronize());
@@ -270,36 +302,49 @@ namespace exemcl::gpu {
                 float alpha = 1.0;
                 float beta = 0.0;
                 CUBLAS_CHECK_RETURN(
-                    cublasSgemv(_handle, CUBLAS_OP_N, S_multi.size(), _vShape[0], &alpha, gpuResultMatrix, S_multi.size(), gpuOneVector, 1, &beta, gpuRowReductionVector, 1));
+                    cublasSgemv(_handle, CUBLAS_OP_N, summaryCount, _vShape[0], &alpha, gpuResultMatrix, summaryCount, gpuOneVector, 1, &beta, gpuRowReductionVector, 1));
             } else if constexpr (std::is_same<HostDataType, double>::value) {
                 double alpha = 1.0;
                 double beta = 0.0;
                 CUBLAS_CHECK_RETURN(
-                    cublasDgemv(_handle, CUBLAS_OP_N, S_multi.size(), _vShape[0], &alpha, gpuResultMatrix, S_multi.size(), gpuOneVector, 1, &beta, gpuRowReductionVector, 1));
+                    cublasDgemv(_handle, CUBLAS_OP_N, summaryCount, _vShape[0], &alpha, gpuResultMatrix, summaryCount, gpuOneVector, 1, &beta, gpuRowReductionVector, 1));
             }
 
-            std::vector<HostDataType> finalResultVector(S_multi.size(), 0.0);
-            CUDA_CHECK_RETURN(cudaMemcpy(finalResultVector.data(), gpuRowReductionVector, S_multi.size() * sizeof(HostDataType), cudaMemcpyDeviceToHost));
+            std::vector<HostDataType> finalResultVector(summaryCount, 0.0);
+            CUDA_CHECK_RETURN(cudaMemcpy(finalResultVector.data(), gpuRowReductionVector, summaryCount * sizeof(HostDataType), cudaMemcpyDeviceToHost));
 
-            // Release data.
-            delete[] summarySizes;
-            delete summaryMatrix;
-            CUDA_CHECK_RETURN(cudaFree(gpuSummaryMatrix));
-            CUDA_CHECK_RETURN(cudaFree(gpuSummarySizes));
-            CUDA_CHECK_RETURN(cudaFree(gpuResultMatrix));
             CUDA_CHECK_RETURN(cudaFree(gpuOneVector));
             CUDA_CHECK_RETURN(cudaFree(gpuRowReductionVector));
 
-            // Check, whether we have to cast float to double.
-            if constexpr (std::is_same<HostDataType, double>::value) {
-                return finalResultVector;
-            } else if constexpr (std::is_same<HostDataType, float>::value) {
-                std::vector<double> finalResultVectorFloat(finalResultVector.begin(), finalResultVector.end());
-                return finalResultVectorFloat;
-            }
+            return std::vector<double>(finalResultVector.begin(), finalResultVector.end());
+        };
+
+        /**
+         * Sums up the result matrix for every summary using fp64 accumulators (see `compensatedReductionKernel`).
+         * @param gpuResultMatrix The result matrix in GPU memory.
+         * @param summaryCount The number of summaries.
+         * @return The sum for every summary.
+         */
+        std::vector<double> reduceCompensated(HostDataType* gpuResultMatrix, unsigned long summaryCount) const {
+            const unsigned int threadCount = 256;
+
+            double* gpuRowReductionVector;
+            CUDA_CHECK_RETURN(cudaMalloc((void**) &gpuRowReductionVector, summaryCount * sizeof(double)));
+
+            // The kernel is queued behind the distance kernel, hence no explicit synchronization is required beforehand.
+            compensatedReductionKernel<HostDataType>
+                <<<summaryCount, threadCount, threadCount * sizeof(double)>>>(gpuResultMatrix, (int) _vShape[0], (int) summaryCount, gpuRowReductionVector);
+            CUDA_CHECK_RETURN(cudaDeviceSynchronize());
+            CUDA_CHECK_RETURN(cudaPeekAtLastError());
+
+            std::vector<double> finalResultVector(summaryCount, 0.0);
+            CUDA_CHECK_RETURN(cudaMemcpy(finalResultVector.data(), gpuRowReductionVector, summaryCount * sizeof(double), cudaMemcpyDeviceToHost));
+            CUDA_CHECK_RETURN(cudaFree(gpuRowReductionVector));
+
+            return finalResultVector;
         };
 
-        HostDataType L(const MatrixX<HostDataType>& S) const {
+        double L(const MatrixX<HostDataType>& S) const {
             std::vector<MatrixX<HostDataType>> S_multi = {S};
             return L(S_multi)[0];
         };
@@ -0,0 +1,300 @@
+#ifndef EXEMCL_IO_CSVREADER_H
+#define EXEMCL_IO_CSVREADER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <src/function/SubmodularFunction.h>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace exemcl {
+    /**
+     * A parallel reader for delimited text files (e.g. CSV exports of ground sets and subsets).
+     *
+     * The file is memory-mapped and split into chunks, whose boundaries are moved to the next line break, such that every chunk holds whole lines. The lines of every chunk
+     * are counted in parallel, which yields the first row of every chunk. Afterwards, every chunk is parsed in parallel (using `std::from_chars`) straight into its rows of a
+     * preallocated row-major matrix, hence no intermediate strings are created. Empty lines are skipped and Windows line endings are accepted.
+     */
+    class CSVReader {
+    public:
+        /**
+         * Maps the file and splits it into line-aligned chunks.
+         *
+         * @param path Path to the file.
+         * @param delimiter The delimiter of the fields.
+         * @param header If true, the first line holds the column names. Otherwise, the columns are named `C0`, `C1`, ...
+         * @param workerCount The number of workers to employ (defaults to -1, i.e. all available cores).
+         */
+        explicit CSVReader(const std::string& path, char delimiter = ',', bool header = true, int workerCount = -1) : _path(path), _delimiter(delimiter) {
+            _workerCount = resolveWorkerCount(workerCount);
+
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("CSVReader::CSVReader: Unable to open '" + path + "'.");
+            struct stat status {};
+            fstat(fd, &status);
+            _length = status.st_size;
+            if (_length > 0) {
+                _base = mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (_base == MAP_FAILED) {
+                    _base = nullptr;
+                    close(fd);
+                    throw std::runtime_error("CSVReader::CSVReader: Unable to map '" + path + "' (" + std::strerror(errno) + ").");
+                }
+                madvise(_base, _length, MADV_SEQUENTIAL);
+                madvise(_base, _length, MADV_WILLNEED);
+            }
+            close(fd);
+
+            // The first non-empty line either holds the column names or determines the number of columns.
+            const char* begin = data();
+            const char* end = begin + _length;
+            const char* lineBegin = begin;
+            while (lineBegin < end && (*lineBegin == '\n' || *lineBegin == '\r'))
+                lineBegin++;
+            const char* lineEnd = std::find(lineBegin, end, '\n');
+            std::vector<std::string> firstFields;
+            if (lineBegin < end) {
+                const char* trimmedEnd = lineEnd > lineBegin && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+                for (const char* field = lineBegin;;) {
+                    const char* fieldEnd = std::find(field, trimmedEnd, _delimiter);
+                    firstFields.emplace_back(field, fieldEnd);
+                    if (fieldEnd == trimmedEnd)
+                        break;
+                    field = fieldEnd + 1;
+                }
+            }
+            if (header) {
+                _columns = std::move(firstFields);
+                _dataOffset = lineEnd < end ? lineEnd + 1 - begin : _length;
+            } else {
+                for (unsigned long j = 0; j < firstFields.size(); j++)
+                    _columns.push_back("C" + std::to_string(j));
+                _dataOffset = lineBegin - begin;
+            }
+
+            // Split the data into line-aligned chunks (several per worker for load balancing) and count their lines.
+            const unsigned long dataLength = _length - _dataOffset;
+            const unsigned long chunkCount = std::max<unsigned long>(1, std::min<unsigned long>(4ul * _workerCount, dataLength / MinChunkLength));
+            _chunkBegins.resize(chunkCount + 1);
+            _chunkBegins[0] = _dataOffset;
+            _chunkBegins[chunkCount] = _length;
+            for (unsigned long c = 1; c < chunkCount; c++) {
+                const char* split = std::find(begin + std::max(_dataOffset + c * (dataLength / chunkCount), _chunkBegins[c - 1]), end, '\n');
+                _chunkBegins[c] = split < end ? split + 1 - begin : _length;
+            }
+
+            _chunkRows.assign(chunkCount + 1, 0);
+#pragma omp parallel for num_threads(_workerCount) schedule(dynamic)
+            for (unsigned long c = 0; c < chunkCount; c++)
+                forEachLine(c, [&](const char*, const char*) { _chunkRows[c + 1]++; });
+            for (unsigned long c = 0; c < chunkCount; c++)
+                _chunkRows[c + 1] += _chunkRows[c];
+        };
+
+        CSVReader(const CSVReader&) = delete;
+        CSVReader& operator=(const CSVReader&) = delete;
+
+        /**
+         * Unmaps the file.
+         */
+        ~CSVReader() {
+            if (_base != nullptr)
+                munmap(_base, _length);
+        };
+
+        /**
+         * Returns the column names.
+         * @return As stated above.
+         */
+        const std::vector<std::string>& getColumns() const {
+            return _columns;
+        };
+
+        /**
+         * Returns the number of (non-empty) data lines.
+         * @return As stated above.
+         */
+        unsigned long rows() const {
+            return _chunkRows.back();
+        };
+
+        /**
+         * Parses all columns except for `excludedColumns` (e.g. the index column) into a row-major matrix.
+         *
+         * @param excludedColumns Names of columns, which are skipped. Names, which do not exist, are ignored.
+         * @return The matrix (rows in file order, columns in header order).
+         */
+        template<typename HostDataType = double>
+        MatrixX<HostDataType> readMatrix(const std::vector<std::string>& excludedColumns = {"ObjectID"}) const {
+            std::vector<long> target = columnTargets(excludedColumns);
+            const long cols = std::count_if(target.begin(), target.end(), [](long j) { return j >= 0; });
+            MatrixX<HostDataType> matrix(rows(), cols);
+
+            std::mutex errorMutex;
+            std::string error;
+            std::atomic<bool> failed(false);
+#pragma omp parallel for num_threads(_workerCount) schedule(dynamic)
+            for (unsigned long c = 0; c < _chunkBegins.size() - 1; c++) {
+                unsigned long row = _chunkRows[c];
+                forEachLine(c, [&](const char* lineBegin, const char* lineEnd) {
+                    if (failed.load(std::memory_order_relaxed))
+                        return;
+                    std::string message = parseLine(lineBegin, lineEnd, target, matrix.row(row).data());
+                    if (!message.empty()) {
+                        std::lock_guard<std::mutex> lock(errorMutex);
+                        if (!failed.exchange(true))
+                            error = "CSVReader::readMatrix: " + message + " in line " + std::to_string(row + 1) + " of the data of '" + _path + "'.";
+                    }
+                    row++;
+                });
+            }
+            if (failed)
+                throw std::runtime_error(error);
+            return matrix;
+        };
+
+        /**
+         * Parses a subset file, whose rows are grouped by the integral column `groupColumn`, into one matrix per group (the layout of multi-set evaluations). Groups are
+         * numbered from zero, the rows of a group keep their order within the file and groups without any row yield empty matrices.
+         *
+         * @param groupColumn The name of the grouping column.
+         * @param excludedColumns Names of further columns, which are skipped.
+         * @return The sets \f$S_0, ..., S_{m-1}\f$.
+         */
+        template<typename HostDataType = double>
+        std::vector<MatrixX<HostDataType>> readSubsets(const std::string& groupColumn = "subset_idx", const std::vector<std::string>& excludedColumns = {"ObjectID"}) const {
+            auto groupIt = std::find(_columns.begin(), _columns.end(), groupColumn);
+            if (groupIt == _columns.end())
+                throw std::runtime_error("CSVReader::readSubsets: The grouping column '" + groupColumn + "' does not exist in '" + _path + "'.");
+
+            // Parse the grouping column in double precision, such that large group indices are represented exactly.
+            std::vector<std::string> otherColumns;
+            for (auto& column : _columns)
+                if (column != groupColumn)
+                    otherColumns.push_back(column);
+            std::vector<std::string> pointExclusions = excludedColumns;
+            pointExclusions.push_back(groupColumn);
+            const VectorX<double> groups = readMatrix<double>(otherColumns).col(0);
+            const MatrixX<HostDataType> points = readMatrix<HostDataType>(pointExclusions);
+
+            std::vector<unsigned long> counts;
+            std::vector<unsigned long> groupOf(groups.size());
+            for (Eigen::Index i = 0; i < groups.size(); i++) {
+                if (groups[i] < 0 || groups[i] != std::floor(groups[i]))
+                    throw std::runtime_error("CSVReader::readSubsets: The grouping column holds an invalid index (" + std::to_string(groups[i]) + ") in line "
+                                             + std::to_string(i + 1) + " of the data of '" + _path + "'.");
+                groupOf[i] = static_cast<unsigned long>(groups[i]);
+                if (groupOf[i] >= counts.size())
+                    counts.resize(groupOf[i] + 1, 0);
+                counts[groupOf[i]]++;
+            }
+
+            std::vector<MatrixX<HostDataType>> subsets(counts.size());
+            for (unsigned long k = 0; k < counts.size(); k++)
+                subsets[k].resize(counts[k], points.cols());
+            std::fill(counts.begin(), counts.end(), 0);
+            for (Eigen::Index i = 0; i < groups.size(); i++)
+                subsets[groupOf[i]].row(counts[groupOf[i]]++) = points.row(i);
+            return subsets;
+        };
+
+    private:
+        // Chunks are not split any further, if they would hold less data than this.
+        static constexpr unsigned long MinChunkLength = 1ul << 16;
+
+        std::string _path;
+        char _delimiter;
+        unsigned int _workerCount;
+        void* _base = nullptr;
+        unsigned long _length = 0;
+        unsigned long _dataOffset = 0;
+        std::vector<std::string> _columns;
+        std::vector<unsigned long> _chunkBegins;
+        std::vector<unsigned long> _chunkRows;
+
+        const char* data() const {
+            return static_cast<const char*>(_base);
+        };
+
+        /**
+         * Calls `visitor(lineBegin, lineEnd)` for every non-empty line of chunk `c` (without the line break).
+         */
+        template<typename Visitor>
+        void forEachLine(unsigned long c, Visitor&& visitor) const {
+            const char* position = data() + _chunkBegins[c];
+            const char* end = data() + _chunkBegins[c + 1];
+            while (position < end) {
+                const char* lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+                const char* trimmedEnd = lineEnd > position && lineEnd[-1] == '\r' ? lineEnd - 1 : lineEnd;
+                if (trimmedEnd > position)
+                    visitor(position, trimmedEnd);
+                position = lineEnd + 1;
+            }
+        };
+
+        /**
+         * Maps every column to its index within the parsed matrix (or -1, if it is skipped).
+         */
+        std::vector<long> columnTargets(const std::vector<std::string>& excludedColumns) const {
+            std::vector<long> target(_columns.size(), -1);
+            long cols = 0;
+            for (unsigned long j = 0; j < _columns.size(); j++)
+                if (std::find(excludedColumns.begin(), excludedColumns.end(), _columns[j]) == excludedColumns.end())
+                    target[j] = cols++;
+            return target;
+        };
+
+        /**
+         * Parses the fields of a single line into `row`. Returns an error message, if the line is malformed.
+         */
+        template<typename HostDataType>
+        std::string parseLine(const char* position, const char* end, const std::vector<long>& target, HostDataType* row) const {
+            for (unsigned long j = 0; j < target.size(); j++) {
+                if (j > 0) {
+                    if (position >= end || *position != _delimiter)
+                        return "Expected " + std::to_string(target.size()) + " fields, found " + std::to_string(j);
+                    position++;
+                }
+                const char* fieldEnd = static_cast<const char*>(std::memchr(position, _delimiter, end - position));
+                if (fieldEnd == nullptr)
+                    fieldEnd = end;
+                if (target[j] >= 0) {
+                    // `std::from_chars` neither accepts leading whitespace nor a leading plus sign.
+                    const char* fieldBegin = position;
+                    while (fieldBegin < fieldEnd && (*fieldBegin == ' ' || *fieldBegin == '\t'))
+                        fieldBegin++;
+                    if (fieldBegin < fieldEnd && *fieldBegin == '+')
+                        fieldBegin++;
+                    HostDataType value;
+                    auto result = std::from_chars(fieldBegin, fieldEnd, value);
+                    const char* parsedEnd = result.ptr;
+                    while (parsedEnd < fieldEnd && (*parsedEnd == ' ' || *parsedEnd == '\t'))
+                        parsedEnd++;
+                    if (result.ec != std::errc() || parsedEnd != fieldEnd)
+                        return "Could not convert '" + std::string(position, fieldEnd) + "' to a floating-point number";
+                    row[target[j]] = value;
+                }
+                position = fieldEnd;
+            }
+            if (position != end)
+                return "Expected " + std::to_string(target.size()) + " fields, found more";
+            return "";
+        };
+    };
+}
+
+#endif // EXEMCL_IO_CSVREADER_H
@@ -8,6 +8,9 @@ namespace exemcl {
     template<typename HostDataType, Eigen::StorageOptions DefaultStorage = Eigen::RowMajor>
     using MatrixX = Eigen::Matrix<HostDataType, Eigen::Dynamic, Eigen::Dynamic, DefaultStorage>;
 
+    template<typename HostDataType>
+    using ConstMatrixXRef = Eigen::Ref<const MatrixX<HostDataType>>;
+
     template<typename HostDataType>
     using VectorX = Eigen::Matrix<HostDataType, Eigen::Dynamic, 1>;
 
@@ -0,0 +1,267 @@
+#ifndef EXEMCL_IO_FUNCTIONARTIFACT_H
+#define EXEMCL_IO_FUNCTIONARTIFACT_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <vector>
+
+namespace exemcl {
+    /**
+     * Identifies the arrays stored in a function artifact. The ground set is stored last, such that it can be mapped as a raw file (see `MappedGroundSet::fromRaw`). The
+     * parameters of the dissimilarity (see `SquaredEuclidean::parameters`) are stored in double precision, whereas all other arrays use the scalar type of the function.
+     */
+    enum class ArtifactSection : unsigned int {
+        Weights = 0,             // Per-point weights (optional).
+        Projection,              // Projection matrix of the dimensionality reduction (optional).
+        Mean,                    // Mean of the dimensionality reduction (optional).
+        Residuals,               // Residual norms of the projected ground set (optional).
+        FullGroundSet,           // Full-dimensional ground set in exact-residual mode (optional).
+        DissimilarityParameters, // Parameters of the dissimilarity, e.g. the weights of `DiagonalMahalanobis` (optional).
+        GroundSet,               // The prepared (and possibly projected) ground set.
+        Count
+    };
+
+    /**
+     * The fixed-size header of a function artifact, i.e. a binary file holding the preprocessed state of a function. All arrays are stored row-major in the native
+     * byte order of the writing build, and every array starts at a page boundary, hence the ground set can be mapped without any copy.
+     */
+    struct FunctionArtifactHeader {
+        static constexpr char Magic[8] = {'E', 'X', 'E', 'M', 'C', 'L', 'F', 'A'};
+        static constexpr uint32_t CurrentVersion = 2;
+        static constexpr uint32_t EndiannessProbe = 0x01020304;
+        static constexpr uint64_t Alignment = 4096;
+
+        static constexpr uint32_t Weighted = 1;      // The ground set is weighted.
+        static constexpr uint32_t Reduced = 2;       // The ground set has been projected by a dimensionality reduction.
+        static constexpr uint32_t ExactResidual = 4; // The dimensionality reduction is used for pruning only.
+
+        char magic[8];
+        uint32_t version;
+        uint32_t endianness;
+        uint32_t scalarSize;
+        uint32_t flags;
+        char dissimilarity[32];
+        uint32_t reductionMethod;
+        uint32_t reserved;
+        double zeroVecValue;
+        double totalWeight;
+        uint64_t sections[static_cast<unsigned int>(ArtifactSection::Count)][3]; // Offset (in bytes), rows and columns of every array (zero, if absent).
+
+        /**
+         * Creates a header, which describes the layout of the running build.
+         *
+         * @param scalarSize The size of a scalar (in bytes).
+         * @param dissimilarityName The name of the dissimilarity policy.
+         * @return As stated above.
+         */
+        static FunctionArtifactHeader create(uint32_t scalarSize, const std::string& dissimilarityName) {
+            FunctionArtifactHeader header {};
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = CurrentVersion;
+            header.endianness = EndiannessProbe;
+            header.scalarSize = scalarSize;
+            std::strncpy(header.dissimilarity, dissimilarityName.c_str(), sizeof(header.dissimilarity) - 1);
+            return header;
+        };
+
+        /**
+         * Returns the offset, the rows and the columns of an array.
+         * @return As stated above.
+         */
+        const uint64_t* section(ArtifactSection id) const {
+            return sections[static_cast<unsigned int>(id)];
+        };
+
+        /**
+         * Returns the size of a scalar of an array (in bytes).
+         * @return As stated above.
+         */
+        uint64_t scalarSizeOf(ArtifactSection id) const {
+            return id == ArtifactSection::DissimilarityParameters ? sizeof(double) : scalarSize;
+        };
+
+        /**
+         * Returns true, if the artifact holds the given array.
+         * @return As stated above.
+         */
+        bool has(ArtifactSection id) const {
+            return section(id)[1] * section(id)[2] > 0;
+        };
+    };
+
+    /**
+     * Fills the section table of a function artifact, i.e. assigns a page-aligned offset to every present array in the order of `ArtifactSection`.
+     *
+     * @param header The header, whose section table is filled.
+     * @param arrays One pointer per section (or nullptr, if absent), alongside the number of rows and columns.
+     * @return The size of the artifact (in bytes).
+     */
+    inline uint64_t layoutFunctionArtifact(FunctionArtifactHeader& header, const std::vector<std::tuple<const void*, uint64_t, uint64_t>>& arrays) {
+        if (arrays.size() != static_cast<unsigned int>(ArtifactSection::Count))
+            throw std::runtime_error("layoutFunctionArtifact: Expected one array per section.");
+
+        auto align = [](uint64_t offset) { return (offset + FunctionArtifactHeader::Alignment - 1) / FunctionArtifactHeader::Alignment * FunctionArtifactHeader::Alignment; };
+        uint64_t offset = align(sizeof(FunctionArtifactHeader)), size = offset;
+        for (unsigned int k = 0; k < arrays.size(); k++) {
+            auto [data, rows, cols] = arrays[k];
+            header.sections[k][0] = header.sections[k][1] = header.sections[k][2] = 0;
+            if (data == nullptr || rows * cols == 0)
+                continue;
+            header.sections[k][0] = offset;
+            header.sections[k][1] = rows;
+            header.sections[k][2] = cols;
+            size = offset + rows * cols * header.scalarSizeOf(static_cast<ArtifactSection>(k));
+            offset = align(size);
+        }
+        return size;
+    }
+
+    /**
+     * Writes `length` bytes to a file descriptor, retrying after partial writes and interruptions.
+     *
+     * @param fd The file descriptor.
+     * @param data The bytes to write.
+     * @param length The number of bytes.
+     * @return True, if all bytes have been written.
+     */
+    inline bool writeAll(int fd, const void* data, uint64_t length) {
+        const char* bytes = static_cast<const char*>(data);
+        while (length > 0) {
+            const ssize_t count = write(fd, bytes, length);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return false;
+            bytes += count;
+            length -= count;
+        }
+        return true;
+    }
+
+    /**
+     * Writes a function artifact. The arrays are written in the order of `ArtifactSection`. The file is written to a unique temporary path next to `path` and renamed
+     * afterwards, hence readers never observe a partially written artifact, and concurrent writers of the same artifact never share a temporary file.
+     *
+     * @param path Path of the artifact.
+     * @param header The header, whose section table is filled by this function.
+     * @param arrays One pointer per section (or nullptr, if absent), alongside the number of rows and columns.
+     */
+    inline void writeFunctionArtifact(const std::string& path, FunctionArtifactHeader header, const std::vector<std::tuple<const void*, uint64_t, uint64_t>>& arrays) {
+        layoutFunctionArtifact(header, arrays);
+
+        // The temporary file is named after the process and a per-process sequence number. Exclusive creation skips names, which are taken (e.g. by another host).
+        static std::atomic<unsigned long> sequence {0};
+        std::string temporaryPath;
+        int fd = -1;
+        for (unsigned int attempt = 0; fd < 0 && attempt < 16; attempt++) {
+            temporaryPath = path + "." + std::to_string(getpid()) + "." + std::to_string(sequence++) + ".tmp";
+            fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0666);
+            if (fd < 0 && errno != EEXIST)
+                break;
+        }
+        if (fd < 0)
+            throw std::runtime_error("writeFunctionArtifact: Unable to create a temporary file for '" + path + "' (" + std::strerror(errno) + ").");
+
+        bool written = writeAll(fd, &header, sizeof(header));
+        uint64_t position = sizeof(header);
+        for (unsigned int k = 0; written && k < arrays.size(); k++) {
+            if (header.sections[k][1] * header.sections[k][2] == 0)
+                continue;
+            // Pad up to the beginning of the array.
+            std::vector<char> padding(header.sections[k][0] - position, 0);
+            const uint64_t length = header.sections[k][1] * header.sections[k][2] * header.scalarSizeOf(static_cast<ArtifactSection>(k));
+            written = writeAll(fd, padding.data(), padding.size()) && writeAll(fd, std::get<0>(arrays[k]), length);
+            position = header.sections[k][0] + length;
+        }
+        written = close(fd) == 0 && written;
+        if (!written) {
+            std::remove(temporaryPath.c_str());
+            throw std::runtime_error("writeFunctionArtifact: Unable to write '" + temporaryPath + "'.");
+        }
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            std::remove(temporaryPath.c_str());
+            throw std::runtime_error("writeFunctionArtifact: Unable to move the artifact to '" + path + "'.");
+        }
+    }
+
+    /**
+     * Validates the header of a function artifact. The artifact needs to match the version and the byte order of the running build, and its sections need to lie
+     * within the artifact.
+     *
+     * @param header The header, whose dissimilarity name is terminated by this function.
+     * @param size The size of the artifact (in bytes).
+     * @param name The path or the name of the artifact (for error messages).
+     */
+    inline void validateFunctionArtifactHeader(FunctionArtifactHeader& header, uint64_t size, const std::string& name) {
+        if (std::memcmp(header.magic, FunctionArtifactHeader::Magic, sizeof(header.magic)) != 0)
+            throw std::runtime_error("validateFunctionArtifactHeader: '" + name + "' is not a function artifact.");
+        if (header.version != FunctionArtifactHeader::CurrentVersion)
+            throw std::runtime_error("validateFunctionArtifactHeader: '" + name + "' has been written in version " + std::to_string(header.version) + ", but version "
+                                     + std::to_string(FunctionArtifactHeader::CurrentVersion) + " is required.");
+        if (header.endianness != FunctionArtifactHeader::EndiannessProbe)
+            throw std::runtime_error("validateFunctionArtifactHeader: The byte order of '" + name + "' does not match the host.");
+        header.dissimilarity[sizeof(header.dissimilarity) - 1] = '\0';
+        for (unsigned int k = 0; k < static_cast<unsigned int>(ArtifactSection::Count); k++) {
+            const uint64_t* section = header.sections[k];
+            if (section[1] * section[2] > 0 && section[0] + section[1] * section[2] * header.scalarSizeOf(static_cast<ArtifactSection>(k)) > size)
+                throw std::runtime_error("validateFunctionArtifactHeader: '" + name + "' is truncated.");
+        }
+    }
+
+    /**
+     * Reads and validates the header of a function artifact. The artifact needs to match the version and the byte order of the running build, and its sections need to
+     * lie within the file.
+     *
+     * @param path Path of the artifact.
+     * @return As stated above.
+     */
+    inline FunctionArtifactHeader readFunctionArtifactHeader(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw std::runtime_error("readFunctionArtifactHeader: Unable to open '" + path + "'.");
+        const uint64_t size = file.tellg();
+        file.seekg(0);
+
+        FunctionArtifactHeader header {};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            throw std::runtime_error("readFunctionArtifactHeader: '" + path + "' is not a function artifact.");
+        validateFunctionArtifactHeader(header, size, path);
+        return header;
+    }
+
+    /**
+     * Reads an array of a function artifact into memory.
+     *
+     * @param path Path of the artifact.
+     * @param header The header of the artifact.
+     * @param id The array to read.
+     * @return The array as row-major matrix (empty, if absent).
+     */
+    template<typename HostDataType>
+    MatrixX<HostDataType> readFunctionArtifactSection(const std::string& path, const FunctionArtifactHeader& header, ArtifactSection id) {
+        if (header.scalarSizeOf(id) != sizeof(HostDataType))
+            throw std::runtime_error("readFunctionArtifactSection: The scalar size of '" + path + "' does not match the requested type.");
+        const uint64_t* section = header.section(id);
+        MatrixX<HostDataType> matrix(section[1], section[2]);
+        if (matrix.size() == 0)
+            return matrix;
+
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(section[0]);
+        if (!file.read(reinterpret_cast<char*>(matrix.data()), matrix.size() * sizeof(HostDataType)))
+            throw std::runtime_error("readFunctionArtifactSection: Unable to read '" + path + "'.");
+        return matrix;
+    }
+}
+
+#endif // EXEMCL_IO_FUNCTIONARTIFACT_H
@@ -0,0 +1,251 @@
+#ifndef EXEMCL_IO_MAPPEDGROUNDSET_H
+#define EXEMCL_IO_MAPPEDGROUNDSET_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <src/io/DataTypes.h>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace exemcl {
+    /**
+     * Describes the layout of a two-dimensional `.npy` file.
+     */
+    struct NpyHeader {
+        std::string descr;            // The NumPy type descriptor (e.g. `<f4`).
+        unsigned long rows = 0;       // The number of rows.
+        unsigned long cols = 0;       // The number of columns.
+        unsigned long dataOffset = 0; // The offset of the data (in bytes) from the beginning of the file.
+    };
+
+    /**
+     * Reads the header of a `.npy` file (format versions 1.0 to 3.0), which needs to hold a C-contiguous matrix (or a vector, which is interpreted as a single column).
+     *
+     * @param path Path to the file.
+     * @return As stated above.
+     */
+    inline NpyHeader readNpyHeader(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("readNpyHeader: Unable to open '" + path + "'.");
+
+        char magic[8];
+        if (!file.read(magic, 8) || std::memcmp(magic, "\x93NUMPY", 6) != 0)
+            throw std::runtime_error("readNpyHeader: '" + path + "' is not a .npy file.");
+        const unsigned int major = static_cast<unsigned char>(magic[6]);
+
+        // Version 1.0 stores the header length in 2 bytes, later versions use 4 bytes (both little-endian).
+        unsigned char lengthBytes[4] = {0, 0, 0, 0};
+        const unsigned int lengthSize = major == 1 ? 2 : 4;
+        if (!file.read(reinterpret_cast<char*>(lengthBytes), lengthSize))
+            throw std::runtime_error("readNpyHeader: Truncated header in '" + path + "'.");
+        const unsigned long headerLength = lengthBytes[0] | (lengthBytes[1] << 8) | (lengthBytes[2] << 16) | (static_cast<unsigned long>(lengthBytes[3]) << 24);
+        std::string header(headerLength, '\0');
+        if (!file.read(&header[0], headerLength))
+            throw std::runtime_error("readNpyHeader: Truncated header in '" + path + "'.");
+
+        // The header is a Python dictionary literal, e.g. {'descr': '<f4', 'fortran_order': False, 'shape': (1000, 16), }.
+        auto valueOf = [&](const std::string& key) {
+            auto pos = header.find("'" + key + "'");
+            if (pos == std::string::npos)
+                throw std::runtime_error("readNpyHeader: Missing key '" + key + "' in '" + path + "'.");
+            pos = header.find(':', pos);
+            return header.substr(pos + 1);
+        };
+
+        NpyHeader result;
+        std::string descr = valueOf("descr");
+        auto quoteBegin = descr.find('\'');
+        result.descr = descr.substr(quoteBegin + 1, descr.find('\'', quoteBegin + 1) - quoteBegin - 1);
+
+        std::string fortranOrder = valueOf("fortran_order");
+        if (fortranOrder.compare(fortranOrder.find_first_not_of(' '), 5, "False") != 0)
+            throw std::runtime_error("readNpyHeader: '" + path + "' needs to be stored in C order.");
+
+        std::string shape = valueOf("shape");
+        shape = shape.substr(shape.find('(') + 1, shape.find(')') - shape.find('(') - 1);
+        std::vector<unsigned long> dims;
+        size_t pos = 0;
+        while (pos < shape.size()) {
+            size_t next = shape.find(',', pos);
+            std::string token = shape.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+            if (token.find_first_not_of(' ') != std::string::npos)
+                dims.push_back(std::stoul(token));
+            if (next == std::string::npos)
+                break;
+            pos = next + 1;
+        }
+        if (dims.empty() || dims.size() > 2)
+            throw std::runtime_error("readNpyHeader: '" + path + "' needs to hold a vector or a matrix.");
+        result.rows = dims[0];
+        result.cols = dims.size() == 2 ? dims[1] : 1;
+        result.dataOffset = 8 + lengthSize + headerLength;
+
+        return result;
+    }
+
+    /**
+     * A read-only ground set, which is memory-mapped from a `.npy` or a raw (little-endian, row-major) binary file.
+     *
+     * The file is mapped as shared memory without any private copy, hence all processes on a host, which map the same file, share a single copy in the page cache and
+     * startup does not depend on the size of the file. The mapping keeps the default access policy of the kernel: every evaluation rescans V, which may be shared by many
+     * functions, hence pages must not be dropped behind a scan (as the sequential hint would). Reading the whole file ahead on startup is opt-in. Since the mapping is
+     * read-only, it can only be evaluated by dissimilarities, which do not need to transform the ground set (see `SquaredEuclidean` and `Manhattan`).
+     */
+    template<typename HostDataType = float>
+    class MappedGroundSet {
+    public:
+        /**
+         * Maps a `.npy` file, whose type needs to match `HostDataType` (`<f4` for float or `<f8` for double).
+         *
+         * @param path Path to the file.
+         * @param prefetch If true, the kernel starts reading the whole file ahead asynchronously (defaults to false, i.e. pages are read on first access).
+         * @return The mapped ground set.
+         */
+        static std::shared_ptr<const MappedGroundSet> fromNpy(const std::string& path, bool prefetch = false) {
+            NpyHeader header = readNpyHeader(path);
+            if (header.descr != descriptor())
+                throw std::runtime_error("MappedGroundSet::fromNpy: The type of '" + path + "' (" + header.descr + ") does not match the expected type (" + descriptor() + ").");
+            return std::shared_ptr<const MappedGroundSet>(new MappedGroundSet(path, header.dataOffset, header.rows, header.cols, prefetch));
+        };
+
+        /**
+         * Maps a raw binary file, which stores a row-major matrix of little-endian values of type `HostDataType`.
+         *
+         * @param path Path to the file.
+         * @param cols The number of columns (the number of rows follows from the file size).
+         * @param offset The offset of the data (in bytes) from the beginning of the file.
+         * @param prefetch If true, the kernel starts reading the whole file ahead asynchronously (defaults to false, i.e. pages are read on first access).
+         * @return The mapped ground set.
+         */
+        static std::shared_ptr<const MappedGroundSet> fromRaw(const std::string& path, unsigned long cols, unsigned long offset = 0, bool prefetch = false) {
+            if (cols == 0)
+                throw std::runtime_error("MappedGroundSet::fromRaw: The number of columns needs to be positive.");
+            struct stat status {};
+            if (stat(path.c_str(), &status) != 0)
+                throw std::runtime_error("MappedGroundSet::fromRaw: Unable to open '" + path + "'.");
+            if (static_cast<unsigned long>(status.st_size) < offset)
+                throw std::runtime_error("MappedGroundSet::fromRaw: The offset exceeds the size of '" + path + "'.");
+            const unsigned long rows = (status.st_size - offset) / (cols * sizeof(HostDataType));
+            return std::shared_ptr<const MappedGroundSet>(new MappedGroundSet(path, offset, rows, cols, prefetch));
+        };
+
+        /**
+         * Maps a row-major matrix of type `HostDataType` from a POSIX shared memory object (see `shm_open`).
+         *
+         * @param name The name of the shared memory object (e.g. `/exemcl_1234`).
+         * @param cols The number of columns.
+         * @param offset The offset of the data (in bytes) from the beginning of the object.
+         * @param rows The number of rows.
+         * @return The mapped ground set.
+         */
+        static std::shared_ptr<const MappedGroundSet> fromSharedMemory(const std::string& name, unsigned long cols, unsigned long offset, unsigned long rows) {
+            return std::shared_ptr<const MappedGroundSet>(new MappedGroundSet(name, offset, rows, cols, false, true));
+        };
+
+        MappedGroundSet(const MappedGroundSet&) = delete;
+        MappedGroundSet& operator=(const MappedGroundSet&) = delete;
+
+        /**
+         * Unmaps the file.
+         */
+        ~MappedGroundSet() {
+            if (_base != nullptr)
+                munmap(_base, _length);
+        };
+
+        /**
+         * Returns the ground set as a (read-only) Eigen matrix, which references the mapping.
+         * @return As stated above.
+         */
+        Eigen::Map<const MatrixX<HostDataType>> matrix() const {
+            return Eigen::Map<const MatrixX<HostDataType>>(_data, _rows, _cols);
+        };
+
+        /**
+         * Returns the number of points.
+         * @return As stated above.
+         */
+        unsigned long rows() const {
+            return _rows;
+        };
+
+        /**
+         * Returns the dimensionality of the points.
+         * @return As stated above.
+         */
+        unsigned long cols() const {
+            return _cols;
+        };
+
+        /**
+         * Returns the path of the mapped file (or the name of the shared memory object).
+         * @return As stated above.
+         */
+        const std::string& getPath() const {
+            return _path;
+        };
+
+    private:
+        std::string _path;
+        void* _base = nullptr;
+        size_t _length = 0;
+        const HostDataType* _data = nullptr;
+        unsigned long _rows;
+        unsigned long _cols;
+
+        static std::string descriptor() {
+            static_assert(std::is_same<HostDataType, float>::value || std::is_same<HostDataType, double>::value, "Mapped ground sets need to be of type float or double.");
+            return std::is_same<HostDataType, float>::value ? "<f4" : "<f8";
+        };
+
+        MappedGroundSet(const std::string& path, unsigned long offset, unsigned long rows, unsigned long cols, bool prefetch, bool sharedMemory = false) :
+            _path(path), _rows(rows), _cols(cols) {
+            const uint16_t endiannessProbe = 1;
+            if (*reinterpret_cast<const uint8_t*>(&endiannessProbe) != 1)
+                throw std::runtime_error("MappedGroundSet::MappedGroundSet: Mapping little-endian files requires a little-endian host.");
+            if (offset % sizeof(HostDataType) != 0)
+                throw std::runtime_error("MappedGroundSet::MappedGroundSet: The data offset of '" + path + "' is not aligned to the size of its elements.");
+
+            int fd = sharedMemory ? shm_open(path.c_str(), O_RDONLY, 0) : open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("MappedGroundSet::MappedGroundSet: Unable to open '" + path + "'.");
+            struct stat status {};
+            fstat(fd, &status);
+            const size_t required = offset + static_cast<size_t>(rows) * cols * sizeof(HostDataType);
+            if (static_cast<size_t>(status.st_size) < required) {
+                close(fd);
+                throw std::runtime_error("MappedGroundSet::MappedGroundSet: '" + path + "' is smaller than its header suggests.");
+            }
+
+            // Map the whole file, since the data offset is usually not page-aligned.
+            _length = std::max<size_t>(status.st_size, 1);
+            _base = mmap(nullptr, _length, PROT_READ, MAP_SHARED, fd, 0);
+            if (_base == MAP_FAILED) {
+                _base = nullptr;
+                close(fd);
+                throw std::runtime_error("MappedGroundSet::MappedGroundSet: Unable to map '" + path + "' (" + std::strerror(errno) + ").");
+            }
+
+            // Hints are not binding, hence failures are ignored.
+            if (prefetch) {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                madvise(_base, _length, MADV_WILLNEED);
+            }
+            close(fd);
+
+            _data = reinterpret_cast<const HostDataType*>(static_cast<const char*>(_base) + offset);
+        };
+    };
+}
+
+#endif // EXEMCL_IO_MAPPEDGROUNDSET_H
@@ -0,0 +1,112 @@
+#ifndef EXEMCL_OPTIMIZER_MIXEDPRECISIONGREEDY_H
+#define EXEMCL_OPTIMIZER_MIXEDPRECISIONGREEDY_H
+
+#include <algorithm>
+#include <src/function/SubmodularFunction.h>
+#include <vector>
+
+namespace exemcl {
+    /**
+     * Holds the outcome of a greedy optimization.
+     */
+    struct GreedyResult {
+        std::vector<unsigned long> indices; // Indices of the selected candidates (in order of selection).
+        MatrixX<double> S;                  // The selected exemplars.
+        std::vector<double> gains;          // The exact marginal gain of every selected exemplar.
+        double value = 0.0;                 // The exact function value f(S).
+        unsigned long reranked = 0;         // The number of candidates, which have been re-evaluated by the exact function (summed over all steps).
+    };
+
+    /**
+     * This class implements the greedy algorithm for cardinality-constrained maximization in mixed precision. In every step, the marginal gains of all remaining candidates
+     * are computed by a fast, low-precision function (e.g. an fp16, fp32 or int8 instance of the exemplar clustering function). Only the candidates, whose approximate gain
+     * is within an error margin of the best approximate gain, are re-evaluated by an exact (fp64) function, which finally selects the exemplar.
+     *
+     * If the error of every approximate gain is bounded by \f$\delta\f$, a margin of \f$2\delta\f$ guarantees, that the exact best candidate is re-evaluated. Hence, the
+     * selected exemplars match those of a greedy optimization, which solely uses the exact function. The margin is computed as
+     * `absoluteMargin + relativeMargin * |best approximate gain|`, as the error of low-precision functions typically scales with the magnitude of the gains.
+     */
+    class MixedPrecisionGreedy {
+    public:
+        /**
+         * Constructs the mixed precision greedy optimizer.
+         *
+         * @param fastFunction The low-precision function, which is used to score all candidates.
+         * @param exactFunction The exact function, which is used to re-rank near-tied candidates.
+         * @param absoluteMargin The absolute part of the error margin.
+         * @param relativeMargin The part of the error margin, which is relative to the best approximate gain.
+         */
+        MixedPrecisionGreedy(const SubmodularFunction& fastFunction, const SubmodularFunction& exactFunction, double absoluteMargin = 0.0, double relativeMargin = 0.01) :
+            _fastFunction(fastFunction), _exactFunction(exactFunction), _absoluteMargin(absoluteMargin), _relativeMargin(relativeMargin) {
+            if (absoluteMargin < 0.0 || relativeMargin < 0.0)
+                throw std::runtime_error("MixedPrecisionGreedy::MixedPrecisionGreedy: The error margins must not be negative.");
+        };
+
+        /**
+         * Selects `k` exemplars from a set of candidates.
+         *
+         * @param candidates The candidates (one per row), e.g. the ground set V.
+         * @param k The number of exemplars to select.
+         * @return The selected exemplars alongside their exact gains and function value.
+         */
+        GreedyResult optimize(const MatrixX<double>& candidates, unsigned int k) const {
+            if (k > candidates.rows())
+                throw std::runtime_error("MixedPrecisionGreedy::optimize: Cannot select " + std::to_string(k) + " out of " + std::to_string(candidates.rows()) + " candidates.");
+
+            MatrixX<double> candidatesCopy = candidates;
+            std::vector<bool> selected(candidates.rows(), false);
+            GreedyResult result;
+            result.S.resize(0, candidates.cols());
+
+            for (unsigned int step = 0; step < k; step++) {
+                // Score all remaining candidates in low precision.
+                std::vector<unsigned long> remaining;
+                std::vector<VectorXRef<double>> elems;
+                remaining.reserve(candidates.rows() - step);
+                elems.reserve(candidates.rows() - step);
+                for (Eigen::Index i = 0; i < candidatesCopy.rows(); i++) {
+                    if (!selected[i]) {
+                        remaining.push_back(i);
+                        elems.emplace_back(candidatesCopy.row(i));
+                    }
+                }
+                std::vector<double> fastGains = _fastFunction(result.S, elems);
+
+                // Shortlist all candidates within the error margin of the best approximate gain.
+                double bestFastGain = *std::max_element(fastGains.begin(), fastGains.end());
+                double threshold = bestFastGain - (_absoluteMargin + _relativeMargin * std::abs(bestFastGain));
+                std::vector<unsigned long> shortlist;
+                std::vector<VectorXRef<double>> shortlistElems;
+                for (unsigned long i = 0; i < remaining.size(); i++) {
+                    if (fastGains[i] >= threshold) {
+                        shortlist.push_back(remaining[i]);
+                        shortlistElems.push_back(elems[i]);
+                    }
+                }
+
+                // Re-rank the shortlist in full precision. Ties are broken in favor of the lower index, as done by a plain greedy optimization.
+                std::vector<double> exactGains = _exactFunction(result.S, shortlistElems);
+                unsigned long best = std::max_element(exactGains.begin(), exactGains.end()) - exactGains.begin();
+                result.reranked += shortlist.size();
+
+                // Update the result.
+                selected[shortlist[best]] = true;
+                result.indices.push_back(shortlist[best]);
+                result.gains.push_back(exactGains[best]);
+                result.S.conservativeResize(result.S.rows() + 1, Eigen::NoChange_t());
+                result.S.row(result.S.rows() - 1) = candidates.row(shortlist[best]);
+            }
+            result.value = _exactFunction(result.S);
+
+            return result;
+        };
+
+    private:
+        const SubmodularFunction& _fastFunction;
+        const SubmodularFunction& _exactFunction;
+        double _absoluteMargin;
+        double _relativeMargin;
+    };
+}
+
+#endif // EXEMCL_OPTIMIZER_MIXEDPRECISIONGREEDY_H
@@ -0,0 +1,100 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <linux/perf_event.h>
+#include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace exemcl;
+
+/**
+ * Counts the data TLB misses of the process (including all threads created afterwards). If the counter is unavailable (e.g. within a container), `read` yields -1.
+ */
+class TLBMissCounter {
+public:
+    TLBMissCounter() {
+        perf_event_attr attributes {};
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attributes.disabled = 1;
+        attributes.inherit = 1;
+        attributes.exclude_kernel = 1;
+        _fd = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    }
+
+    ~TLBMissCounter() {
+        if (_fd >= 0)
+            close(_fd);
+    }
+
+    void start() {
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    long read() {
+        long count = -1;
+        if (_fd >= 0) {
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (::read(_fd, &count, sizeof(count)) != sizeof(count))
+                count = -1;
+        }
+        return count;
+    }
+
+private:
+    int _fd;
+};
+
+/**
+ * Measures the mean runtime (in milliseconds) and the mean number of TLB misses of an evaluation of `S` with the given allocation policy.
+ */
+template<typename Allocation>
+void benchmark(const MatrixX<float>& V, const MatrixX<double>& S, int workerCount, unsigned int repetitions, TLBMissCounter& counter) {
+    cpu::ExemplarClusteringSubmodularFunction<float, SquaredEuclidean, Allocation> function(V, workerCount);
+    function(S); // Warm up.
+
+    counter.start();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; r++)
+        function(S);
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    long misses = counter.read();
+
+    double throughput = static_cast<double>(V.rows()) * (S.rows() + 1) / (time * 1e6);
+    std::cout << std::setw(10) << Allocation::name << std::setw(14) << std::fixed << std::setprecision(3) << time << std::setw(18) << std::setprecision(2) << throughput
+              << std::setw(18);
+    if (misses >= 0)
+        std::cout << misses / repetitions << std::endl;
+    else
+        std::cout << "n/a" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    Eigen::Index n = argc > 1 ? std::stol(argv[1]) : 4000000;
+    Eigen::Index d = argc > 2 ? std::stol(argv[2]) : 16;
+    Eigen::Index m = argc > 3 ? std::stol(argv[3]) : 32;
+    int workerCount = argc > 4 ? std::stoi(argv[4]) : -1;
+    unsigned int repetitions = argc > 5 ? std::stoi(argv[5]) : 10;
+
+    MatrixX<float> V = MatrixX<float>::Random(n, d);
+    MatrixX<double> S = MatrixX<double>::Random(m, d);
+    TLBMissCounter counter;
+
+    std::cout << "|V| = " << n << ", d = " << d << ", |S| = " << m << ", workers = " << (workerCount >= 1 ? workerCount : std::thread::hardware_concurrency())
+              << std::endl;
+    std::cout << std::setw(10) << "policy" << std::setw(14) << "time [ms]" << std::setw(18) << "dist. [1e6/ms]" << std::setw(18) << "dTLB misses" << std::endl;
+    benchmark<cpu::DefaultAllocation>(V, S, workerCount, repetitions, counter);
+    benchmark<cpu::AlignedAllocation>(V, S, workerCount, repetitions, counter);
+    benchmark<cpu::TransparentHugePageAllocation>(V, S, workerCount, repetitions, counter);
+    benchmark<cpu::ExplicitHugePageAllocation>(V, S, workerCount, repetitions, counter);
+
+    return 0;
+}
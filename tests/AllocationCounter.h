@@ -0,0 +1,55 @@
+#ifndef EXEMCL_TESTS_ALLOCATIONCOUNTER_H
+#define EXEMCL_TESTS_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+/**
+ * Counts the heap allocations of the test executable (of all threads), e.g. to verify that repeated evaluations do not allocate. The allocation functions of the C library
+ * are interposed, hence allocations by `operator new`, Eigen and the OpenMP runtime are counted alike. The counter is only available with glibc, which exports the
+ * underlying allocation functions.
+ */
+namespace exemcl::testing {
+    inline std::atomic<unsigned long> allocationCount(0);
+}
+
+#if defined(__GLIBC__)
+    #define EXEMCL_ALLOCATION_COUNTER_AVAILABLE
+
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+    exemcl::testing::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+    exemcl::testing::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, std::size_t size) noexcept {
+    exemcl::testing::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(pointer, size);
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+    exemcl::testing::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, std::size_t alignment, std::size_t size) noexcept {
+    exemcl::testing::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer != nullptr || size == 0 ? 0 : ENOMEM;
+}
+}
+#endif
+
+#endif // EXEMCL_TESTS_ALLOCATIONCOUNTER_H
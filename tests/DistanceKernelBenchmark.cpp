@@ -0,0 +1,56 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <src/function/cpu/DistanceKernels.h>
+#include <vector>
+
+using namespace exemcl;
+
+/**
+ * Measures the mean runtime of a kernel (in milliseconds).
+ */
+template<typename Kernel>
+double measure(Kernel kernel, unsigned int repetitions) {
+    kernel(); // Warm up.
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int r = 0; r < repetitions; r++)
+        kernel();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+}
+
+template<typename HostDataType, int Dim>
+void benchmark(Eigen::Index n, Eigen::Index m, unsigned int workerCount, unsigned int repetitions) {
+    MatrixX<HostDataType> V = MatrixX<HostDataType>::Random(n, Dim);
+    MatrixX<HostDataType> S = MatrixX<HostDataType>::Random(m, Dim);
+    std::vector<HostDataType> minDistances(n);
+
+    double dynamicTime = measure([&]() { cpu::kernels::minDissimilarities<HostDataType>(V, S, minDistances.data(), workerCount); }, repetitions);
+    double fixedTime = measure([&]() { cpu::kernels::minDissimilarities<HostDataType, SquaredEuclidean, Dim>(V, S, minDistances.data(), workerCount); }, repetitions);
+
+    std::cout << std::setw(8) << (sizeof(HostDataType) == 4 ? "fp32" : "fp64") << std::setw(6) << Dim << std::setw(14) << std::fixed << std::setprecision(3) << dynamicTime
+              << std::setw(14) << fixedTime << std::setw(10) << std::setprecision(2) << dynamicTime / fixedTime << "x" << std::endl;
+}
+
+template<typename HostDataType>
+void benchmarkAll(Eigen::Index n, Eigen::Index m, unsigned int workerCount, unsigned int repetitions) {
+    benchmark<HostDataType, 2>(n, m, workerCount, repetitions);
+    benchmark<HostDataType, 3>(n, m, workerCount, repetitions);
+    benchmark<HostDataType, 8>(n, m, workerCount, repetitions);
+    benchmark<HostDataType, 16>(n, m, workerCount, repetitions);
+    benchmark<HostDataType, 32>(n, m, workerCount, repetitions);
+    benchmark<HostDataType, 64>(n, m, workerCount, repetitions);
+}
+
+int main(int argc, char** argv) {
+    Eigen::Index n = argc > 1 ? std::stol(argv[1]) : 100000;
+    Eigen::Index m = argc > 2 ? std::stol(argv[2]) : 32;
+    unsigned int workerCount = argc > 3 ? std::stoi(argv[3]) : 1;
+    unsigned int repetitions = argc > 4 ? std::stoi(argv[4]) : 10;
+
+    std::cout << "|V| = " << n << ", |S| = " << m << ", workers = " << workerCount << std::endl;
+    std::cout << std::setw(8) << "type" << std::setw(6) << "d" << std::setw(14) << "dynamic [ms]" << std::setw(14) << "fixed [ms]" << std::setw(11) << "speedup" << std::endl;
+    benchmarkAll<float>(n, m, workerCount, repetitions);
+    benchmarkAll<double>(n, m, workerCount, repetitions);
+
+    return 0;
+}
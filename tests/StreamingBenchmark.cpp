@@ -0,0 +1,86 @@
+#include <chrono>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <src/function/cpu/StreamingExemplarClusteringSubmodularFunction.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace exemcl;
+
+/**
+ * Writes a random ground set of `n` points of dimensionality `d` as raw binary file and flushes it to the disk.
+ */
+void writeGroundSet(const std::string& path, Eigen::Index n, Eigen::Index d) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Unable to create '" + path + "'.");
+    const Eigen::Index blockRows = std::max<Eigen::Index>((16l << 20) / (d * sizeof(float)), 1);
+    for (Eigen::Index i = 0; i < n; i += blockRows) {
+        MatrixX<float> block = MatrixX<float>::Random(std::min(blockRows, n - i), d);
+        if (write(fd, block.data(), block.size() * sizeof(float)) != static_cast<ssize_t>(block.size() * sizeof(float)))
+            throw std::runtime_error("Unable to write '" + path + "'.");
+    }
+    fsync(fd);
+    close(fd);
+}
+
+/**
+ * Drops the (clean) pages of a file from the page cache, such that the next pass is served by the disk.
+ */
+void dropCache(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+/**
+ * Measures the time (in seconds) of a plain sequential read of the file in blocks of 16 MiB, i.e. the throughput ceiling of the disk.
+ */
+double readFile(const std::string& path) {
+    std::vector<char> buffer(16l << 20);
+    auto start = std::chrono::steady_clock::now();
+    int fd = open(path.c_str(), O_RDONLY);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    off_t position = 0;
+    ssize_t count;
+    while ((count = pread(fd, buffer.data(), buffer.size(), position)) > 0)
+        position += count;
+    close(fd);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "exemcl-streaming-benchmark.bin";
+    Eigen::Index n = argc > 2 ? std::stol(argv[2]) : 8000000;
+    Eigen::Index d = argc > 3 ? std::stol(argv[3]) : 32;
+    Eigen::Index m = argc > 4 ? std::stol(argv[4]) : 8;
+    int workerCount = argc > 5 ? std::stoi(argv[5]) : -1;
+    long memoryLimit = argc > 6 ? std::stol(argv[6]) << 20 : cpu::StreamingExemplarClusteringSubmodularFunction<float>::DefaultMemoryLimit;
+    unsigned int repetitions = argc > 7 ? std::stoi(argv[7]) : 3;
+
+    writeGroundSet(path, n, d);
+    const double megabytes = static_cast<double>(n) * d * sizeof(float) / (1 << 20);
+    MatrixX<double> S = MatrixX<double>::Random(m, d);
+    cpu::StreamingExemplarClusteringSubmodularFunction<float> function(path, d, memoryLimit, workerCount);
+    function(S); // Computes L({0}).
+
+    std::cout << "|V| = " << n << ", d = " << d << ", |S| = " << m << ", file = " << std::fixed << std::setprecision(0) << megabytes << " MiB, chunk = "
+              << function.getChunkRows() << " points" << std::endl;
+    std::cout << std::setw(12) << "pass" << std::setw(14) << "read [MiB/s]" << std::setw(14) << "f(S) [MiB/s]" << std::setw(10) << "ratio" << std::endl;
+    for (unsigned int r = 0; r < repetitions; r++) {
+        dropCache(path);
+        double readTime = readFile(path);
+
+        dropCache(path);
+        auto start = std::chrono::steady_clock::now();
+        function(S);
+        double passTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::setw(12) << r << std::setw(14) << std::setprecision(1) << megabytes / readTime << std::setw(14) << megabytes / passTime << std::setw(10)
+                  << std::setprecision(2) << readTime / passTime << std::endl;
+    }
+
+    unlink(path.c_str());
+    return 0;
+}
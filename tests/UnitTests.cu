@@ -1,9 +1,25 @@
 #include <Eigen/Eigen>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <src/function/SubmodularFunction.h>
+#include <src/function/cpu/CoresetBuilder.h>
+#include <src/function/cpu/ExemplarClusteringEstimator.h>
+#include <src/function/cpu/ExemplarClusteringIncrementalState.h>
 #include <src/function/cpu/ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/HalfPrecisionExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/Int8ExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/MicroClusterExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/ProductQuantizedExemplarClusteringSubmodularFunction.h>
+#include <src/function/cpu/SharedMemoryGroundSet.h>
+#include <src/function/cpu/StreamingExemplarClusteringSubmodularFunction.h>
 #include <src/function/gpu/ExemplarClusteringSubmodularFunction.cuh>
-#include <tests/CSVFile.h>
+#include <src/io/CSVReader.h>
+#include <src/io/MappedGroundSet.h>
+#include <src/optimizer/MixedPrecisionGreedy.h>
+#include <sstream>
+#include <thread>
+#include <tests/AllocationCounter.h>
 
 #ifndef EXEMCL_TESTFILES_DIR
 #error No testfile directory supplied. Compilation aborted.
@@ -25,27 +41,10 @@ SubmodularTestData loadSubmodularTestData(const std::string& subdir) {
     SubmodularTestData testData;
 
     // Load test data.
-    testData.groundSet = CSVFile::readCSVFile(TESTFILES_ROOT + subdir + "/ground_set.csv", ',')->asMatrix().cast<double>();
-    exemcl::MatrixX<double> subsetsMatrix = CSVFile::readCSVFile(TESTFILES_ROOT + subdir + "/subsets.csv", ',')->asMatrix().cast<double>();
-    std::vector<std::vector<exemcl::VectorX<double>>> subsetVectors;
-    for (unsigned int i = 0; i < subsetsMatrix.rows(); i++) {
-        exemcl::VectorX<double> matrixRow = subsetsMatrix.row(i);
-        unsigned int subsetIdx = matrixRow[subsetsMatrix.cols() - 1];
-        if (subsetIdx >= subsetVectors.size())
-            subsetVectors.emplace_back();
-        subsetVectors[subsetIdx].push_back(matrixRow.head(matrixRow.rows() - 1));
-    }
-
-    // Create subsets.
-    for (auto& subset : subsetVectors) {
-        exemcl::MatrixX<double> subsetMatrix(subset.size(), testData.groundSet.cols());
-        for (unsigned int i = 0; i < subset.size(); i++)
-            subsetMatrix.row(i) = subset[i];
-        testData.subsets.push_back(subsetMatrix);
-    }
-
-    testData.fValuesExpected = CSVFile::readCSVFile(TESTFILES_ROOT + subdir + "/f_values.csv", ',')->asMatrix().col(0).cast<double>();
-    testData.marginalsExpected = CSVFile::readCSVFile(TESTFILES_ROOT + subdir + "/marginal_values.csv", ',')->asMatrix().col(0).cast<double>();
+    testData.groundSet = exemcl::CSVReader(TESTFILES_ROOT + subdir + "/ground_set.csv").readMatrix();
+    testData.subsets = exemcl::CSVReader(TESTFILES_ROOT + subdir + "/subsets.csv").readSubsets();
+    testData.fValuesExpected = exemcl::CSVReader(TESTFILES_ROOT + subdir + "/f_values.csv").readMatrix().col(0);
+    testData.marginalsExpected = exemcl::CSVReader(TESTFILES_ROOT + subdir + "/marginal_values.csv").readMatrix().col(0);
     testData.marginal = testData.groundSet.row(testData.groundSet.rows() - 1);
 
     return testData;
@@ -89,9 +88,14 @@ void testSubmodularFunction(exemcl::SubmodularFunction& submodularFunction, Subm
     }
 }
 
+// With compensated reductions (the default), FP32 engines match the FP64 reference up to rounding errors of the per-point distances.
 #define FP16_ERROR_TOLERANCY 0.01f
-#define FP32_ERROR_TOLERANCY 0.001f
+#define FP32_ERROR_TOLERANCY 0.00001
 #define FP64_ERROR_TOLERANCY 0.000000000001
+#define BF16_RELATIVE_ERROR_TOLERANCY 0.01
+#define PQ_RELATIVE_ERROR_TOLERANCY 0.01
+#define INT8_RELATIVE_ERROR_TOLERANCY 0.01
+#define CORESET_RELATIVE_ERROR_TOLERANCY 0.05
 
 using DeviceDataTypes = ::testing::Types<__half, float, double>;
 template<typename T>
@@ -175,6 +179,32 @@ TYPED_TEST(GPUTests, ExemplarClusteringChunked) {
     }
 }
 
+template<typename DeviceDataType, typename Dissimilarity>
+void testGPUDissimilarity(SubmodularTestData& testData, const Dissimilarity& dissimilarity, double tolerancy) {
+    // The fp64 CPU implementation serves as reference.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<double, Dissimilarity> referenceFunction(testData.groundSet, -1, dissimilarity);
+    exemcl::gpu::ExemplarClusteringSubmodularFunction<DeviceDataType, DeviceDataType, Dissimilarity> submodularFunction(testData.groundSet.cast<DeviceDataType>(), -1,
+                                                                                                                        dissimilarity);
+
+    auto fValuesExpected = referenceFunction(testData.subsets);
+    auto fValuesComputed = submodularFunction(testData.subsets);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++)
+        EXPECT_NEAR(fValuesExpected[i], fValuesComputed[i], tolerancy * std::max(1.0, std::abs(fValuesExpected[i])));
+}
+
+TYPED_TEST(GPUTests, ExemplarClusteringDissimilarity) {
+    if constexpr (std::is_same<TypeParam, float>::value || std::is_same<TypeParam, double>::value) {
+        // Load test data.
+        SubmodularTestData testData = loadSubmodularTestData("exem");
+        double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+        exemcl::VectorX<double> weights = exemcl::VectorX<double>::LinSpaced(testData.groundSet.cols(), 0.5, 2.0);
+
+        testGPUDissimilarity<TypeParam>(testData, exemcl::Manhattan(), tolerancy);
+        testGPUDissimilarity<TypeParam>(testData, exemcl::Cosine(), tolerancy);
+        testGPUDissimilarity<TypeParam>(testData, exemcl::DiagonalMahalanobis(weights), tolerancy);
+    }
+}
+
 using HostDataTypes = ::testing::Types<float, double>;
 template<typename T>
 class CPUTests : public ::testing::Test { };
@@ -208,6 +238,958 @@ TYPED_TEST(CPUTests, ExemplarClusteringMT) {
         testSubmodularFunction(submodularFunction, testData, FP64_ERROR_TOLERANCY);
 }
 
+TYPED_TEST(CPUTests, ExemplarClusteringIncremental) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+
+    // Create the incremental state and a reference function.
+    exemcl::cpu::ExemplarClusteringIncrementalState<TypeParam> incrementalState(testData.groundSet.cast<TypeParam>(), 8, -1);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> submodularFunction(testData.groundSet.cast<TypeParam>(), -1);
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+
+    for (unsigned long i = 0; i < testData.subsets.size(); i++) {
+        // Build the first few elements incrementally and check, that the realized gains match the function.
+        incrementalState.reset();
+        for (unsigned int j = 0; j < std::min<Eigen::Index>(testData.subsets[i].rows(), 10); j++) {
+            exemcl::VectorX<double> elem = testData.subsets[i].row(j);
+            double expectedGain = submodularFunction(testData.subsets[i].topRows(j), elem);
+            EXPECT_NEAR(expectedGain, incrementalState.gain(elem), tolerancy);
+            EXPECT_NEAR(expectedGain, incrementalState.add(elem), tolerancy);
+        }
+
+        // Check function value and marginal gain for the complete set.
+        incrementalState.reset();
+        for (unsigned int j = 0; j < testData.subsets[i].rows(); j++)
+            incrementalState.add(testData.subsets[i].row(j).transpose());
+        EXPECT_NEAR(testData.fValuesExpected(i), incrementalState.value(), tolerancy);
+        EXPECT_NEAR(testData.marginalsExpected(i), incrementalState.gain(testData.marginal), tolerancy);
+    }
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringDimensionReduction) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+
+    // The exact-residual mode needs to yield exact results.
+    auto exactReduction = exemcl::cpu::DimensionReduction<TypeParam>::pca(V, 3, true);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> exactFunction(V, exactReduction, -1);
+    testSubmodularFunction(exactFunction, testData, tolerancy);
+
+    // The approximate PCA mode needs to bound the exact function values.
+    auto pcaReduction = exemcl::cpu::DimensionReduction<TypeParam>::pca(V, 5);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> pcaFunction(V, pcaReduction, -1);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++) {
+        auto [lower, upper] = pcaFunction.bounds(testData.subsets[i]);
+        EXPECT_LE(lower, testData.fValuesExpected(i) + tolerancy);
+        EXPECT_GE(upper, testData.fValuesExpected(i) - tolerancy);
+    }
+
+    // Random projections yield ordered bounds around the estimate.
+    auto randomReduction = exemcl::cpu::DimensionReduction<TypeParam>::randomProjection(V.cols(), 8, 42);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> randomFunction(V, randomReduction, -1);
+    for (auto& S : testData.subsets) {
+        auto [lower, upper] = randomFunction.bounds(S);
+        EXPECT_LE(lower, upper);
+    }
+}
+
+template<typename HostDataType, int Dim>
+void testFixedDimensionKernel(double tolerancy) {
+    exemcl::MatrixX<HostDataType> V = exemcl::MatrixX<HostDataType>::Random(1000, Dim);
+    exemcl::MatrixX<HostDataType> S = exemcl::MatrixX<HostDataType>::Random(17, Dim);
+    std::vector<HostDataType> expected(V.rows()), computed(V.rows());
+    exemcl::cpu::kernels::minDissimilarities<HostDataType>(V, S, expected.data(), 1);
+    exemcl::cpu::kernels::dispatchMinDissimilarities<HostDataType>(V, S, computed.data(), 3);
+    for (Eigen::Index i = 0; i < V.rows(); i++)
+        EXPECT_NEAR(expected[i], computed[i], tolerancy);
+}
+
+TYPED_TEST(CPUTests, FixedDimensionKernels) {
+    // Every specialized kernel needs to match the dynamic kernel.
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    testFixedDimensionKernel<TypeParam, 2>(tolerancy);
+    testFixedDimensionKernel<TypeParam, 3>(tolerancy);
+    testFixedDimensionKernel<TypeParam, 8>(tolerancy);
+    testFixedDimensionKernel<TypeParam, 16>(tolerancy);
+    testFixedDimensionKernel<TypeParam, 32>(tolerancy);
+    testFixedDimensionKernel<TypeParam, 64>(tolerancy);
+}
+
+template<typename Dissimilarity>
+double referenceDissimilarity(const exemcl::VectorX<double>& v, const exemcl::VectorX<double>& s, const exemcl::VectorX<double>& weights) {
+    if constexpr (std::is_same<Dissimilarity, exemcl::Manhattan>::value)
+        return (v - s).cwiseAbs().sum();
+    else if constexpr (std::is_same<Dissimilarity, exemcl::Cosine>::value)
+        return s.norm() > 0 ? 1.0 - v.dot(s) / (v.norm() * s.norm()) : 1.0;
+    else
+        return (v - s).cwiseProduct(v - s).dot(weights);
+}
+
+template<typename HostDataType, typename Dissimilarity>
+void testDissimilarity(SubmodularTestData& testData, const exemcl::VectorX<double>& weights, const Dissimilarity& dissimilarity, double tolerancy) {
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<HostDataType, Dissimilarity> submodularFunction(testData.groundSet.cast<HostDataType>(), -1, dissimilarity);
+    exemcl::VectorX<double> zeroVec = exemcl::VectorX<double>::Zero(testData.groundSet.cols());
+
+    for (unsigned long k = 0; k < 5; k++) {
+        // Compute the reference value naively.
+        auto& S = testData.subsets[k];
+        double expected = 0.0;
+        for (Eigen::Index i = 0; i < testData.groundSet.rows(); i++) {
+            exemcl::VectorX<double> v = testData.groundSet.row(i);
+            double minVal = referenceDissimilarity<Dissimilarity>(v, zeroVec, weights);
+            for (Eigen::Index j = 0; j < S.rows(); j++)
+                minVal = std::min(minVal, referenceDissimilarity<Dissimilarity>(v, S.row(j).transpose(), weights));
+            expected += referenceDissimilarity<Dissimilarity>(v, zeroVec, weights) - minVal;
+        }
+        expected /= testData.groundSet.rows();
+
+        EXPECT_NEAR(expected, submodularFunction(S), tolerancy * std::max(1.0, std::abs(expected)));
+    }
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringDissimilarity) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    exemcl::VectorX<double> weights = exemcl::VectorX<double>::LinSpaced(testData.groundSet.cols(), 0.5, 2.0);
+    exemcl::VectorX<double> unitWeights = exemcl::VectorX<double>::Ones(testData.groundSet.cols());
+
+    testDissimilarity<TypeParam>(testData, unitWeights, exemcl::Manhattan(), tolerancy);
+    testDissimilarity<TypeParam>(testData, unitWeights, exemcl::Cosine(), tolerancy);
+    testDissimilarity<TypeParam>(testData, weights, exemcl::DiagonalMahalanobis(weights), tolerancy);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringWeighted) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+
+    // Duplicate every point up to three times.
+    exemcl::MatrixX<TypeParam> V(testData.groundSet.rows() * 2, testData.groundSet.cols());
+    V << testData.groundSet.cast<TypeParam>(), testData.groundSet.cast<TypeParam>();
+    exemcl::MatrixX<TypeParam> VDuplicated(V.rows() + 100, V.cols());
+    VDuplicated << V, V.topRows(100);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> referenceFunction(VDuplicated, -1);
+
+    // Collapsing exact duplicates must not change the function values.
+    auto groundSet = exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(VDuplicated);
+    EXPECT_EQ(groundSet.points.rows(), testData.groundSet.rows());
+    EXPECT_EQ(groundSet.weights.sum(), VDuplicated.rows());
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> weightedFunction(groundSet, -1);
+    for (auto& S : testData.subsets)
+        EXPECT_NEAR(referenceFunction(S), weightedFunction(S), tolerancy);
+
+    // Uniform duplication yields the original function.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> uniformFunction(exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V), -1);
+    testSubmodularFunction(uniformFunction, testData, tolerancy);
+
+    // Near-exact duplicates are collapsed as well.
+    exemcl::MatrixX<TypeParam> VPerturbed = VDuplicated;
+    VPerturbed.bottomRows(100).array() += static_cast<TypeParam>(1e-4);
+    auto perturbedGroundSet = exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(VPerturbed, 0.1);
+    EXPECT_LT(perturbedGroundSet.points.rows(), VPerturbed.rows() / 2);
+    EXPECT_EQ(perturbedGroundSet.weights.sum(), VPerturbed.rows());
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringDeterministic) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+
+    for (auto mode : {exemcl::ReductionMode::Naive, exemcl::ReductionMode::Compensated}) {
+        // Evaluate single-threaded as reference.
+        exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> referenceFunction(V, 1);
+        referenceFunction.setReductionMode(mode);
+        referenceFunction.setDeterministic(true);
+        auto fValuesReference = referenceFunction(testData.subsets);
+        auto marginalsReference = referenceFunction(testData.subsets, testData.marginal);
+
+        // Results need to be bit-identical for every worker count.
+        for (int workerCount : {2, 3, 7}) {
+            exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> submodularFunction(V, workerCount);
+            submodularFunction.setReductionMode(mode);
+            submodularFunction.setDeterministic(true);
+            auto fValuesComputed = submodularFunction(testData.subsets);
+            auto marginalsComputed = submodularFunction(testData.subsets, testData.marginal);
+            for (unsigned long i = 0; i < testData.subsets.size(); i++) {
+                EXPECT_EQ(fValuesReference[i], fValuesComputed[i]);
+                EXPECT_EQ(fValuesReference[i], submodularFunction(testData.subsets[i]));
+                EXPECT_EQ(marginalsReference[i], marginalsComputed[i]);
+            }
+        }
+    }
+}
+
+TEST(CPUTests, ExemplarClusteringFP16) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+
+    // Create submodular function.
+    exemcl::cpu::HalfPrecisionExemplarClusteringSubmodularFunction<Eigen::half> submodularFunction(testData.groundSet.cast<float>(), -1);
+
+    // Run the test function.
+    testSubmodularFunction(submodularFunction, testData, FP16_ERROR_TOLERANCY);
+}
+
+TEST(CPUTests, ExemplarClusteringBF16) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+
+    // Create submodular function.
+    exemcl::cpu::HalfPrecisionExemplarClusteringSubmodularFunction<Eigen::bfloat16> submodularFunction(testData.groundSet.cast<float>(), -1);
+
+    // Function values are approximate.
+    auto fValuesComputedJoint = submodularFunction(testData.subsets);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++)
+        EXPECT_NEAR(testData.fValuesExpected(i), fValuesComputedJoint[i], BF16_RELATIVE_ERROR_TOLERANCY * testData.fValuesExpected(i));
+}
+
+TEST(CPUTests, ExemplarClusteringProductQuantized) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+
+    // Create submodular function.
+    exemcl::cpu::ProductQuantizedExemplarClusteringSubmodularFunction submodularFunction(testData.groundSet.cast<float>(), 10, -1, 8);
+    auto& report = submodularFunction.getReport();
+    EXPECT_LT(report.compressedMemory, report.uncompressedMemory);
+    EXPECT_EQ(report.validationSets, 8);
+    EXPECT_LT(report.maxRelativeError, PQ_RELATIVE_ERROR_TOLERANCY);
+
+    // Function values are approximate.
+    auto fValuesComputedJoint = submodularFunction(testData.subsets);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++)
+        EXPECT_NEAR(testData.fValuesExpected(i), fValuesComputedJoint[i], PQ_RELATIVE_ERROR_TOLERANCY * testData.fValuesExpected(i));
+}
+
+TEST(CPUTests, ExemplarClusteringInt8) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+
+    // Create submodular function.
+    exemcl::cpu::Int8ExemplarClusteringSubmodularFunction submodularFunction(testData.groundSet.cast<float>(), -1);
+    EXPECT_LT(submodularFunction.getMemoryFootprint(), testData.groundSet.size() * sizeof(float));
+
+    // Function values are approximate.
+    auto fValuesComputedJoint = submodularFunction(testData.subsets);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++)
+        EXPECT_NEAR(testData.fValuesExpected(i), fValuesComputedJoint[i], INT8_RELATIVE_ERROR_TOLERANCY * testData.fValuesExpected(i));
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringCoreset) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+
+    // Build a coreset, which compresses the ground set.
+    exemcl::cpu::CoresetBuilder<TypeParam> builder(8, 1, -1);
+    auto coreset = builder.build(V, 400, 8);
+    auto& report = builder.getReport();
+    EXPECT_EQ(report.groundSetSize, V.rows());
+    EXPECT_EQ(report.coresetSize, coreset.points.rows());
+    EXPECT_LT(report.coresetSize, V.rows());
+    EXPECT_EQ(report.validationSets, 8);
+    EXPECT_LT(report.maxRelativeError, CORESET_RELATIVE_ERROR_TOLERANCY);
+    EXPECT_NEAR(coreset.weights.sum(), V.rows(), CORESET_RELATIVE_ERROR_TOLERANCY * V.rows());
+
+    // The coreset approximates the function values.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> coresetFunction(coreset, -1);
+    auto fValuesComputedJoint = coresetFunction(testData.subsets);
+    for (unsigned long i = 0; i < testData.subsets.size(); i++)
+        EXPECT_NEAR(testData.fValuesExpected(i), fValuesComputedJoint[i], CORESET_RELATIVE_ERROR_TOLERANCY * testData.fValuesExpected(i));
+
+    // Smaller errors require larger coresets.
+    EXPECT_LT(builder.sizeForEpsilon(V.cols(), 0.2), builder.sizeForEpsilon(V.cols(), 0.1));
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringEstimator) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    const unsigned long n = V.rows();
+
+    for (auto scheme : {exemcl::cpu::SamplingScheme::Random, exemcl::cpu::SamplingScheme::Stratified, exemcl::cpu::SamplingScheme::Permuted}) {
+        exemcl::cpu::ExemplarClusteringEstimator<TypeParam> estimator(V, scheme, n / 4, 8, 1, -1);
+
+        // The exact values should (mostly) be covered by the confidence intervals.
+        unsigned long covered = 0;
+        for (unsigned long i = 0; i < testData.subsets.size(); i++) {
+            auto result = estimator.estimate(testData.subsets[i], n / 4, 0.99);
+            EXPECT_LE(result.lower, result.value);
+            EXPECT_GE(result.upper, result.value);
+            EXPECT_FALSE(result.exact);
+            if (result.lower <= testData.fValuesExpected(i) && testData.fValuesExpected(i) <= result.upper)
+                covered++;
+        }
+        EXPECT_GE(covered, testData.subsets.size() * 9 / 10);
+
+        // Refinement stops at the target width (or evaluates every point).
+        auto refined = estimator.refine(testData.subsets[0], 0.01 * testData.fValuesExpected(0), 0.0, 0.95, 16);
+        EXPECT_TRUE(refined.exact || refined.width() <= 0.01 * testData.fValuesExpected(0));
+        EXPECT_NEAR(testData.fValuesExpected(0), refined.value, 0.05 * testData.fValuesExpected(0));
+
+        if (scheme != exemcl::cpu::SamplingScheme::Random) {
+            // The fixed permutation yields identical estimates for repeated calls and is exact for the full ground set.
+            EXPECT_EQ(estimator(testData.subsets[1]), estimator(testData.subsets[1]));
+            auto full = estimator.estimate(testData.subsets[1], n);
+            EXPECT_TRUE(full.exact);
+            EXPECT_EQ(full.samples, n);
+            EXPECT_EQ(full.lower, full.upper);
+            EXPECT_NEAR(testData.fValuesExpected(1), full.value, FP32_ERROR_TOLERANCY * testData.fValuesExpected(1));
+
+            // The exact function shares the permuted ground set.
+            EXPECT_NEAR(testData.fValuesExpected(1), estimator.getFunction()(testData.subsets[1]), FP32_ERROR_TOLERANCY * testData.fValuesExpected(1));
+
+            // In deterministic mode, estimates do not depend on the worker count.
+            estimator.setReductionMode(exemcl::ReductionMode::Naive);
+            estimator.setDeterministic(true);
+            EXPECT_TRUE(estimator.getFunction().isDeterministic());
+            const double value = estimator(testData.subsets[1]);
+            estimator.setWorkerCount(1);
+            EXPECT_EQ(estimator(testData.subsets[1]), value);
+        }
+    }
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringRacing) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    exemcl::MatrixX<double> candidates = testData.groundSet.topRows(200);
+    exemcl::MatrixX<double> S(0, V.cols());
+
+    // The exact gains serve as reference.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> exactFunction(V, -1);
+    std::vector<exemcl::VectorXRef<double>> elems;
+    for (Eigen::Index i = 0; i < candidates.rows(); i++)
+        elems.emplace_back(candidates.row(i));
+    std::vector<double> exactGains = exactFunction(S, elems);
+    std::vector<unsigned long> ranking(exactGains.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::stable_sort(ranking.begin(), ranking.end(), [&exactGains](unsigned long a, unsigned long b) { return exactGains[a] > exactGains[b]; });
+
+    for (auto scheme : {exemcl::cpu::SamplingScheme::Stratified, exemcl::cpu::SamplingScheme::Permuted}) {
+        exemcl::cpu::ExemplarClusteringEstimator<TypeParam> estimator(V, scheme, 32, 8, 1, -1);
+
+        // The race needs to select the exact best candidates, whereas most candidates are dropped early.
+        auto best = estimator.bestCandidate(S, candidates, 0.99);
+        ASSERT_EQ(best.indices.size(), 1);
+        EXPECT_EQ(best.indices[0], ranking[0]);
+        EXPECT_NEAR(best.gains[0], exactGains[ranking[0]], FP32_ERROR_TOLERANCY * std::abs(exactGains[ranking[0]]));
+        EXPECT_LT(best.survivors, candidates.rows());
+
+        auto top = estimator.topCandidates(S, candidates, 5, 0.99);
+        ASSERT_EQ(top.indices.size(), 5);
+        for (unsigned int r = 0; r < 5; r++)
+            EXPECT_EQ(top.indices[r], ranking[r]);
+        EXPECT_GE(top.survivors, 5);
+    }
+
+    // On larger ground sets, most candidates are dropped early, hence the race evaluates far fewer pairs than an exhaustive search.
+    std::srand(7);
+    exemcl::MatrixX<TypeParam> largeV = exemcl::MatrixX<TypeParam>::Random(5000, V.cols());
+    exemcl::MatrixX<double> largeCandidates = largeV.topRows(200).template cast<double>();
+    exemcl::cpu::ExemplarClusteringEstimator<TypeParam> largeEstimator(largeV, exemcl::cpu::SamplingScheme::Permuted, 32, 8, 1, -1);
+    auto largeBest = largeEstimator.bestCandidate(S, largeCandidates, 0.99);
+    std::vector<exemcl::VectorXRef<double>> largeElems;
+    for (Eigen::Index i = 0; i < largeCandidates.rows(); i++)
+        largeElems.emplace_back(largeCandidates.row(i));
+    std::vector<double> largeGains = largeEstimator.getFunction()(S, largeElems);
+    ASSERT_EQ(largeBest.indices.size(), 1);
+    EXPECT_EQ(largeBest.indices[0], std::max_element(largeGains.begin(), largeGains.end()) - largeGains.begin());
+    EXPECT_LT(largeBest.evaluations, largeCandidates.rows() * largeV.rows() / 2);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringMicroCluster) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+
+    // Without tolerance, the function is evaluated exactly.
+    exemcl::cpu::MicroClusterExemplarClusteringSubmodularFunction<TypeParam> submodularFunction(V, 0.0, 8, -1);
+    if constexpr (std::is_same<TypeParam, float>::value)
+        testSubmodularFunction(submodularFunction, testData, FP32_ERROR_TOLERANCY);
+    else
+        testSubmodularFunction(submodularFunction, testData, FP64_ERROR_TOLERANCY);
+
+    // Leaves are reduced in the configured mode, hence deterministic results do not depend on the worker count.
+    exemcl::cpu::MicroClusterExemplarClusteringSubmodularFunction<TypeParam> singleWorkerFunction(V, 0.0, 8, 1);
+    for (auto mode : {exemcl::ReductionMode::Naive, exemcl::ReductionMode::Compensated}) {
+        for (auto* f : {&submodularFunction, &singleWorkerFunction}) {
+            f->setReductionMode(mode);
+            f->setDeterministic(true);
+        }
+        EXPECT_EQ(submodularFunction(testData.subsets), singleWorkerFunction(testData.subsets));
+    }
+
+    // Larger tolerances yield valid bounds of the requested width at a lower cost.
+    for (unsigned long i = 0; i < testData.subsets.size(); i++) {
+        const double tolerance = 0.05 * testData.fValuesExpected(i);
+        submodularFunction.setTolerance(0.0);
+        auto exact = submodularFunction.evaluate(testData.subsets[i]);
+        submodularFunction.setTolerance(tolerance);
+        auto approximate = submodularFunction.evaluate(testData.subsets[i]);
+
+        EXPECT_LE(approximate.upper - approximate.lower, tolerance + FP32_ERROR_TOLERANCY);
+        EXPECT_LE(approximate.lower, testData.fValuesExpected(i) + FP32_ERROR_TOLERANCY);
+        EXPECT_GE(approximate.upper, testData.fValuesExpected(i) - FP32_ERROR_TOLERANCY);
+        EXPECT_LE(approximate.evaluatedPoints, exact.evaluatedPoints);
+    }
+}
+
+template<typename HostDataType>
+void writeBinaryGroundSet(const std::string& path, const exemcl::MatrixX<HostDataType>& V, bool npy) {
+    std::ofstream file(path, std::ios::binary);
+    if (npy) {
+        // Pad the header to a multiple of 64 bytes, as done by NumPy.
+        std::string header = "{'descr': '" + std::string(std::is_same<HostDataType, float>::value ? "<f4" : "<f8") + "', 'fortran_order': False, 'shape': ("
+                             + std::to_string(V.rows()) + ", " + std::to_string(V.cols()) + "), }";
+        header.append(64 - (10 + header.size() + 1) % 64, ' ');
+        header.push_back('\n');
+        const uint16_t headerLength = header.size();
+        file.write("\x93NUMPY\x01\x00", 8);
+        file.write(reinterpret_cast<const char*>(&headerLength), 2);
+        file.write(header.data(), header.size());
+    }
+    file.write(reinterpret_cast<const char*>(V.data()), V.size() * sizeof(HostDataType));
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringMapped) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+
+    const std::string prefix = (std::filesystem::temp_directory_path() / ("exemcl_" + std::to_string(getpid()) + "_" + std::to_string(sizeof(TypeParam)))).string();
+    const std::string npyPath = prefix + ".npy";
+    const std::string rawPath = prefix + ".bin";
+    writeBinaryGroundSet(npyPath, V, true);
+    writeBinaryGroundSet(rawPath, V, false);
+
+    // Both mappings expose the ground set without a copy.
+    auto npyGroundSet = exemcl::MappedGroundSet<TypeParam>::fromNpy(npyPath);
+    auto rawGroundSet = exemcl::MappedGroundSet<TypeParam>::fromRaw(rawPath, V.cols());
+    EXPECT_EQ(npyGroundSet->rows(), V.rows());
+    EXPECT_EQ(rawGroundSet->rows(), V.rows());
+    EXPECT_EQ(npyGroundSet->matrix(), V);
+    EXPECT_EQ(rawGroundSet->matrix(), V);
+    using OtherDataType = typename std::conditional<std::is_same<TypeParam, float>::value, double, float>::type;
+    EXPECT_THROW(exemcl::MappedGroundSet<OtherDataType>::fromNpy(npyPath), std::runtime_error);
+
+    // Functions, which share the mapping, are evaluated directly over it.
+    for (auto& groundSet : {npyGroundSet, rawGroundSet}) {
+        exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> submodularFunction(groundSet, -1);
+        if constexpr (std::is_same<TypeParam, float>::value)
+            testSubmodularFunction(submodularFunction, testData, FP32_ERROR_TOLERANCY);
+        else
+            testSubmodularFunction(submodularFunction, testData, FP64_ERROR_TOLERANCY);
+    }
+
+    // L({0}) of a mapping is computed on first use in tiles, whose block sums equal the ones of an in-memory ground set.
+    std::srand(42);
+    exemcl::MatrixX<TypeParam> largeV = exemcl::MatrixX<TypeParam>::Random(70000, 3);
+    const std::string largePath = prefix + "_large.bin";
+    writeBinaryGroundSet(largePath, largeV, false);
+    auto largeGroundSet = exemcl::cpu::GroundSet<TypeParam>::fromMapping(exemcl::MappedGroundSet<TypeParam>::fromRaw(largePath, largeV.cols()));
+    EXPECT_EQ(largeGroundSet->getZeroVecValue(), exemcl::cpu::GroundSet<TypeParam>::create(largeV)->getZeroVecValue());
+    largeGroundSet.reset();
+    std::remove(largePath.c_str());
+
+    npyGroundSet.reset();
+    rawGroundSet.reset();
+    std::remove(npyPath.c_str());
+    std::remove(rawPath.c_str());
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringStreaming) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+
+    const std::string prefix = (std::filesystem::temp_directory_path() / ("exemcl_streaming_" + std::to_string(getpid()) + "_" + std::to_string(sizeof(TypeParam)))).string();
+    const std::string npyPath = prefix + ".npy";
+    const std::string rawPath = prefix + ".bin";
+    writeBinaryGroundSet(npyPath, V, true);
+    writeBinaryGroundSet(rawPath, V, false);
+
+    // A small budget splits the ground set into many chunks, including a partial last chunk.
+    const long memoryLimit = 64 * 2 * (V.cols() + 1) * sizeof(TypeParam) + 1;
+    exemcl::cpu::StreamingExemplarClusteringSubmodularFunction<TypeParam> npyFunction(npyPath, 0, memoryLimit);
+    exemcl::cpu::StreamingExemplarClusteringSubmodularFunction<TypeParam> rawFunction(rawPath, V.cols(), memoryLimit);
+    EXPECT_EQ(npyFunction.rows(), V.rows());
+    EXPECT_EQ(rawFunction.rows(), V.rows());
+    EXPECT_EQ(npyFunction.getChunkRows(), 64);
+    for (auto* submodularFunction : {&npyFunction, &rawFunction}) {
+        if constexpr (std::is_same<TypeParam, float>::value)
+            testSubmodularFunction(*submodularFunction, testData, FP32_ERROR_TOLERANCY);
+        else
+            testSubmodularFunction(*submodularFunction, testData, FP64_ERROR_TOLERANCY);
+    }
+
+    // Batched marginal gains match the in-memory implementation.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> reference(V, -1);
+    exemcl::VectorX<double> elem = testData.groundSet.row(0).transpose();
+    const double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    auto streamedGains = npyFunction(testData.subsets, elem);
+    auto referenceGains = reference(testData.subsets, elem);
+    for (unsigned long i = 0; i < streamedGains.size(); i++)
+        EXPECT_NEAR(streamedGains[i], referenceGains[i], tolerancy);
+
+    // The budget needs to cover at least one point, whereas larger budgets read the ground set at once.
+    EXPECT_THROW(npyFunction.setMemoryLimit(1), std::runtime_error);
+    npyFunction.setMemoryLimit(exemcl::cpu::StreamingExemplarClusteringSubmodularFunction<TypeParam>::DefaultMemoryLimit);
+    EXPECT_EQ(npyFunction.getChunkRows(), V.rows());
+    EXPECT_NEAR(npyFunction(testData.subsets[0]), reference(testData.subsets[0]), tolerancy);
+    using StreamingFunction = exemcl::cpu::StreamingExemplarClusteringSubmodularFunction<TypeParam>;
+    EXPECT_THROW(StreamingFunction{rawPath}, std::runtime_error);
+
+    std::remove(npyPath.c_str());
+    std::remove(rawPath.c_str());
+}
+
+TEST(CPUTests, CSVReader) {
+    const std::string path = (std::filesystem::temp_directory_path() / ("exemcl_csv_" + std::to_string(getpid()) + ".csv")).string();
+    auto writeFile = [&](const std::string& contents) {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    };
+
+    // Index columns are skipped, whereas Windows line endings, empty lines and a missing final line break are accepted.
+    writeFile("ObjectID,a,b,subset_idx\r\n0,1.5,-2,1\r\n\r\n1, +3e2 ,0.25,0\n2,4,5,1");
+    exemcl::CSVReader reader(path);
+    EXPECT_EQ(reader.getColumns(), std::vector<std::string>({"ObjectID", "a", "b", "subset_idx"}));
+    EXPECT_EQ(reader.rows(), 3);
+    exemcl::MatrixX<double> expected(3, 3);
+    expected << 1.5, -2, 1, 300, 0.25, 0, 4, 5, 1;
+    EXPECT_EQ(reader.readMatrix(), expected);
+    EXPECT_EQ(reader.readMatrix<float>({"ObjectID", "subset_idx"}), expected.leftCols(2).cast<float>());
+
+    // Subsets are grouped by their index, keeping the order within the file.
+    auto subsets = reader.readSubsets();
+    ASSERT_EQ(subsets.size(), 2);
+    EXPECT_EQ(subsets[0], expected.block(1, 0, 1, 2));
+    exemcl::MatrixX<double> secondSubset(2, 2);
+    secondSubset << 1.5, -2, 4, 5;
+    EXPECT_EQ(subsets[1], secondSubset);
+
+    // Files without a header and malformed files.
+    writeFile("1,2\n3,4\n");
+    EXPECT_EQ(exemcl::CSVReader(path, ',', false).readMatrix().rows(), 2);
+    writeFile("a,b\n1,2\n3\n");
+    EXPECT_THROW(exemcl::CSVReader(path).readMatrix(), std::runtime_error);
+    writeFile("a,b\n1,x\n");
+    EXPECT_THROW(exemcl::CSVReader(path).readMatrix(), std::runtime_error);
+
+    // Parsing a larger file in parallel chunks matches the serial result.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    std::ostringstream contents;
+    contents.precision(17);
+    contents << "x0";
+    for (Eigen::Index j = 1; j < testData.groundSet.cols(); j++)
+        contents << ",x" << j;
+    contents << "\n";
+    for (int repetition = 0; repetition < 40; repetition++)
+        for (Eigen::Index i = 0; i < testData.groundSet.rows(); i++) {
+            for (Eigen::Index j = 0; j < testData.groundSet.cols(); j++)
+                contents << (j > 0 ? "," : "") << testData.groundSet(i, j);
+            contents << "\n";
+        }
+    writeFile(contents.str());
+    auto parallel = exemcl::CSVReader(path, ',', true, 8).readMatrix();
+    auto serial = exemcl::CSVReader(path, ',', true, 1).readMatrix();
+    ASSERT_EQ(parallel.rows(), 40 * testData.groundSet.rows());
+    EXPECT_EQ(parallel, serial);
+    EXPECT_EQ(parallel.bottomRows(testData.groundSet.rows()), testData.groundSet);
+
+    std::remove(path.c_str());
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringSharedGroundSet) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+
+    // Functions, which share a ground set, reference the same points.
+    auto groundSet = exemcl::cpu::GroundSet<TypeParam>::create(V);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> firstFunction(groundSet, -1);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> secondFunction(groundSet, 1);
+    EXPECT_EQ(groundSet.use_count(), 3);
+    EXPECT_EQ(firstFunction.getV().data(), secondFunction.getV().data());
+    EXPECT_EQ(firstFunction.getV(), V);
+    testSubmodularFunction(firstFunction, testData, tolerancy);
+    testSubmodularFunction(secondFunction, testData, tolerancy);
+
+    // Functions, which have been constructed from V, expose their ground set.
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> ownedFunction(V, -1);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> sharingFunction(ownedFunction.getGroundSet(), -1);
+    EXPECT_EQ(ownedFunction.getV().data(), sharingFunction.getV().data());
+    testSubmodularFunction(sharingFunction, testData, tolerancy);
+
+    // Ground sets are prepared for a single dissimilarity.
+    auto cosineGroundSet = exemcl::cpu::GroundSet<TypeParam>::create(V, exemcl::Cosine());
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::Cosine> cosineFunction(cosineGroundSet, -1);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::Cosine> referenceFunction(V, -1);
+    for (auto& S : testData.subsets)
+        EXPECT_EQ(cosineFunction(S), referenceFunction(S));
+    using Function = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam>;
+    EXPECT_THROW(Function(cosineGroundSet, -1), std::runtime_error);
+
+    // Parameterized dissimilarities need to match the parameters, which have prepared the ground set.
+    exemcl::VectorX<double> weights = exemcl::VectorX<double>::LinSpaced(V.cols(), 0.5, 2.0);
+    auto mahalanobisGroundSet = exemcl::cpu::GroundSet<TypeParam>::create(V, exemcl::DiagonalMahalanobis(weights));
+    EXPECT_TRUE(mahalanobisGroundSet->isPreparedFor(exemcl::DiagonalMahalanobis(weights)));
+    EXPECT_EQ(mahalanobisGroundSet->getDissimilarityParameters(), weights);
+    using MahalanobisFunction = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::DiagonalMahalanobis>;
+    MahalanobisFunction mahalanobisFunction(mahalanobisGroundSet, -1, exemcl::DiagonalMahalanobis(weights));
+    MahalanobisFunction mahalanobisReference(V, -1, exemcl::DiagonalMahalanobis(weights));
+    for (auto& S : testData.subsets)
+        EXPECT_EQ(mahalanobisFunction(S), mahalanobisReference(S));
+    EXPECT_THROW(MahalanobisFunction(mahalanobisGroundSet, -1, exemcl::DiagonalMahalanobis(2.0 * weights)), std::runtime_error);
+    EXPECT_THROW(MahalanobisFunction(mahalanobisGroundSet, -1), std::runtime_error);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringAllocation) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    exemcl::MatrixX<TypeParam> largeV = exemcl::MatrixX<TypeParam>::Random(40000, 16);
+    auto isAligned = [](const void* pointer, std::size_t alignment) { return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0; };
+
+    // Every policy evaluates bit-identically to the default allocation.
+    auto expectPolicy = [&](auto policy, std::size_t alignment) {
+        using Allocation = decltype(policy);
+        exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::SquaredEuclidean, Allocation> function(V, -1);
+        EXPECT_STREQ(function.getGroundSet()->getAllocation(), Allocation::name);
+        EXPECT_EQ(function.getV(), V);
+        testSubmodularFunction(function, testData, tolerancy);
+
+        exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> defaultFunction(largeV, -1);
+        exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::SquaredEuclidean, Allocation> largeFunction(largeV, -1);
+        EXPECT_TRUE(isAligned(largeFunction.getV().data(), alignment));
+        EXPECT_EQ(largeFunction.getV(), largeV);
+        for (auto& S : testData.subsets) {
+            exemcl::MatrixX<double> largeS = exemcl::MatrixX<double>::Random(S.rows(), largeV.cols());
+            EXPECT_EQ(defaultFunction(largeS), largeFunction(largeS));
+        }
+    };
+    expectPolicy(exemcl::cpu::AlignedAllocation(), 64);
+    expectPolicy(exemcl::cpu::TransparentHugePageAllocation(), exemcl::cpu::TransparentHugePageAllocation::HugePageSize);
+    expectPolicy(exemcl::cpu::ExplicitHugePageAllocation(), exemcl::cpu::TransparentHugePageAllocation::HugePageSize);
+
+    // Scratch buffers below a huge page fall back to the aligned allocation.
+    auto small = exemcl::cpu::allocateShared<TypeParam, exemcl::cpu::TransparentHugePageAllocation>(100);
+    auto large = exemcl::cpu::allocateShared<TypeParam, exemcl::cpu::TransparentHugePageAllocation>(1ul << 20);
+    EXPECT_TRUE(isAligned(small.get(), 64));
+    EXPECT_TRUE(isAligned(large.get(), exemcl::cpu::TransparentHugePageAllocation::HugePageSize));
+    std::fill(large.get(), large.get() + (1ul << 20), 1);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringZeroAllocation) {
+#ifndef EXEMCL_ALLOCATION_COUNTER_AVAILABLE
+    GTEST_SKIP() << "Allocations can only be counted with glibc.";
+#endif
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    exemcl::MatrixX<double> S = testData.subsets.back();
+    exemcl::VectorX<double> elem = testData.marginal;
+
+    // Once a call of a given shape has been made, further calls (of that shape or of smaller sets) allocate nothing.
+    auto expectNoAllocations = [&](auto& function) {
+        const double value = function(S);
+        const double gain = function(S, elem);
+        const exemcl::MatrixX<double> smallerS = S.topRows(S.rows() / 2);
+        const unsigned long before = exemcl::testing::allocationCount.load();
+        for (unsigned int r = 0; r < 10; r++) {
+            EXPECT_EQ(function(S), value);
+            EXPECT_EQ(function(S, elem), gain);
+            function(smallerS);
+        }
+        EXPECT_EQ(exemcl::testing::allocationCount.load() - before, 0u);
+    };
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> function(V, 4);
+    expectNoAllocations(function);
+    function.setReductionMode(exemcl::ReductionMode::Naive);
+    function.setDeterministic(true);
+    expectNoAllocations(function);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::SquaredEuclidean, exemcl::cpu::TransparentHugePageAllocation> hugePageFunction(V, 4);
+    expectNoAllocations(hugePageFunction);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::Manhattan> manhattanFunction(exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V), 4);
+    expectNoAllocations(manhattanFunction);
+
+    // The arenas do not change any result, also if several threads evaluate concurrently (and hence hold several arenas).
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> reference(V, 4);
+    reference.setReductionMode(exemcl::ReductionMode::Naive);
+    reference.setDeterministic(true);
+    testSubmodularFunction(function, testData, tolerancy);
+    std::vector<exemcl::VectorXRef<double>> elems;
+    for (unsigned int i = 0; i < 10; i++)
+        elems.emplace_back(testData.groundSet.row(i));
+    EXPECT_EQ(function(testData.subsets), reference(testData.subsets));
+    EXPECT_EQ(function(S, elems), reference(S, elems));
+
+    // Batches hold one arena per concurrent evaluation, but only a single idle arena is retained afterwards.
+    using Function = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam>;
+    EXPECT_EQ(function.getIdleArenaCount(), Function::MaxIdleArenas);
+    EXPECT_EQ(reference.getIdleArenaCount(), Function::MaxIdleArenas);
+    EXPECT_EQ(function(testData.subsets, elems[0]), reference(testData.subsets, elems[0]));
+    EXPECT_EQ(function.getIdleArenaCount(), Function::MaxIdleArenas);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringSharedMemory) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    const std::string name = "/exemcl_test_" + std::to_string(getpid()) + "_" + std::to_string(sizeof(TypeParam));
+
+    // Attached ground sets (as in other processes) evaluate like the published one.
+    using Function = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam>;
+    auto published = std::make_unique<exemcl::cpu::SharedMemoryGroundSet<TypeParam>>(*exemcl::cpu::GroundSet<TypeParam>::create(V), name);
+    EXPECT_EQ(exemcl::cpu::SharedMemoryGroundSet<TypeParam>::scalarSize(name), sizeof(TypeParam));
+    auto attached = exemcl::cpu::SharedMemoryGroundSet<TypeParam>::attach(name);
+    EXPECT_EQ(attached->matrix(), V);
+    Function attachedFunction(attached, -1);
+    testSubmodularFunction(attachedFunction, testData, tolerancy);
+    EXPECT_THROW(exemcl::cpu::SharedMemoryGroundSet<TypeParam>(*attached, name), std::runtime_error);
+
+    // Removing the name keeps existing attachments alive, whereas later attempts fail.
+    published.reset();
+    EXPECT_THROW(exemcl::cpu::SharedMemoryGroundSet<TypeParam>::attach(name), std::runtime_error);
+    testSubmodularFunction(attachedFunction, testData, tolerancy);
+
+    // Weights and prepared points are shared as well.
+    Function weightedFunction(exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V), -1);
+    exemcl::cpu::SharedMemoryGroundSet<TypeParam> weighted(*weightedFunction.getGroundSet(), name);
+    Function sharedWeightedFunction(exemcl::cpu::SharedMemoryGroundSet<TypeParam>::attach(name), -1);
+    for (auto& S : testData.subsets)
+        EXPECT_EQ(weightedFunction(S), sharedWeightedFunction(S));
+    using OtherDataType = typename std::conditional<std::is_same<TypeParam, float>::value, double, float>::type;
+    EXPECT_THROW(exemcl::cpu::SharedMemoryGroundSet<OtherDataType>::attach(name), std::runtime_error);
+
+    // The parameters of the dissimilarity are published alongside the points.
+    exemcl::VectorX<double> weights = exemcl::VectorX<double>::LinSpaced(V.cols(), 0.5, 2.0);
+    using MahalanobisFunction = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::DiagonalMahalanobis>;
+    MahalanobisFunction mahalanobisFunction(V, -1, exemcl::DiagonalMahalanobis(weights));
+    exemcl::cpu::SharedMemoryGroundSet<TypeParam> mahalanobis(*mahalanobisFunction.getGroundSet(), name + "_mahalanobis");
+    auto attachedMahalanobis = exemcl::cpu::SharedMemoryGroundSet<TypeParam>::attach(name + "_mahalanobis");
+    EXPECT_EQ(attachedMahalanobis->getDissimilarityParameters(), weights);
+    MahalanobisFunction sharedMahalanobisFunction(attachedMahalanobis, -1, exemcl::DiagonalMahalanobis(weights));
+    for (auto& S : testData.subsets)
+        EXPECT_EQ(mahalanobisFunction(S), sharedMahalanobisFunction(S));
+    EXPECT_THROW(MahalanobisFunction(attachedMahalanobis, -1, exemcl::DiagonalMahalanobis(2.0 * weights)), std::runtime_error);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringNuma) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+
+    // Split the CPUs of the host into three virtual nodes, such that the shards and the merge are exercised on any host.
+    exemcl::cpu::NumaTopology host = exemcl::cpu::NumaTopology::detect();
+    ASSERT_GE(host.cpuCount(), 1u);
+    std::vector<unsigned int> cpus;
+    for (auto& node : host.getNodes())
+        cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+    std::vector<exemcl::cpu::NumaNode> virtualNodes;
+    for (unsigned int k = 0; k < 3; k++)
+        virtualNodes.push_back({host.getNodes()[0].id, {cpus[k % cpus.size()]}});
+    exemcl::cpu::NumaTopology topology(virtualNodes);
+
+    // The shards cover V and evaluate bit-identically in compensated and deterministic mode.
+    using Function = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam>;
+    exemcl::MatrixX<TypeParam> largeV = exemcl::MatrixX<TypeParam>::Random(3000, V.cols());
+    for (auto placement : {exemcl::cpu::NumaPlacement::FirstTouch, exemcl::cpu::NumaPlacement::Bind}) {
+        auto groundSet = exemcl::cpu::GroundSet<TypeParam>::create(largeV);
+        exemcl::cpu::NumaGroundSet<TypeParam> shards(*groundSet, topology, placement, 4);
+        EXPECT_EQ(shards.shardRows(0) + shards.shardRows(1) + shards.shardRows(2), largeV.rows());
+
+        Function defaultFunction(groundSet, 4), numaFunction(groundSet, 4);
+        numaFunction.setNumaMode(true, placement, topology);
+        EXPECT_TRUE(numaFunction.isNumaMode());
+        for (auto& S : testData.subsets)
+            EXPECT_EQ(defaultFunction(S), numaFunction(S));
+        defaultFunction.setReductionMode(exemcl::ReductionMode::Naive);
+        numaFunction.setReductionMode(exemcl::ReductionMode::Naive);
+        for (auto& S : testData.subsets)
+            EXPECT_NEAR(defaultFunction(S), numaFunction(S), tolerancy * (1.0 + std::abs(defaultFunction(S))));
+        defaultFunction.setDeterministic(true);
+        numaFunction.setDeterministic(true);
+        for (auto& S : testData.subsets)
+            EXPECT_EQ(defaultFunction(S), numaFunction(S));
+        EXPECT_EQ(defaultFunction(testData.subsets), numaFunction(testData.subsets));
+    }
+
+    // Small, weighted and batched evaluations (which evaluate one set at a time) match the default mode as well.
+    Function numaFunction(V, 2);
+    numaFunction.setNumaMode(true, exemcl::cpu::NumaPlacement::FirstTouch, topology);
+    testSubmodularFunction(numaFunction, testData, tolerancy);
+    Function weightedFunction(exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V), -1);
+    Function numaWeightedFunction(weightedFunction.getGroundSet(), -1);
+    numaWeightedFunction.setNumaMode(true, exemcl::cpu::NumaPlacement::FirstTouch, topology);
+    EXPECT_EQ(weightedFunction(testData.subsets), numaWeightedFunction(testData.subsets));
+    numaWeightedFunction.setNumaMode(false);
+    EXPECT_FALSE(numaWeightedFunction.isNumaMode());
+
+    Function reducedFunction(V, exemcl::cpu::DimensionReduction<TypeParam>::pca(V, 3), -1);
+    EXPECT_THROW(reducedFunction.setNumaMode(true), std::runtime_error);
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringArtifact) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<TypeParam> V = testData.groundSet.cast<TypeParam>();
+    double tolerancy = std::is_same<TypeParam, float>::value ? FP32_ERROR_TOLERANCY : FP64_ERROR_TOLERANCY;
+    const std::string path = (std::filesystem::temp_directory_path() / ("exemcl_artifact_" + std::to_string(getpid()) + "_" + std::to_string(sizeof(TypeParam)))).string();
+
+    // Restored functions evaluate exactly like the saved ones.
+    auto expectRestored = [&](const auto& saved, const auto& restored) {
+        for (auto& S : testData.subsets)
+            EXPECT_EQ(saved(S), restored(S));
+    };
+    using Function = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam>;
+    Function plainFunction(V, -1);
+    plainFunction.save(path);
+    auto restoredFunction = Function::load(path);
+    testSubmodularFunction(*restoredFunction, testData, tolerancy);
+    expectRestored(plainFunction, *restoredFunction);
+
+    // Prepared ground sets are stored as such.
+    using CosineFunction = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::Cosine>;
+    CosineFunction cosineFunction(V, -1);
+    cosineFunction.save(path);
+    expectRestored(cosineFunction, *CosineFunction::load(path));
+    EXPECT_THROW(Function::load(path), std::runtime_error);
+
+    // Parameterized dissimilarities are restored from the artifact, and differing parameters of the caller are rejected.
+    exemcl::VectorX<double> weights = exemcl::VectorX<double>::LinSpaced(V.cols(), 0.5, 2.0);
+    using MahalanobisFunction = exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam, exemcl::DiagonalMahalanobis>;
+    MahalanobisFunction mahalanobisFunction(V, -1, exemcl::DiagonalMahalanobis(weights));
+    mahalanobisFunction.save(path);
+    expectRestored(mahalanobisFunction, *MahalanobisFunction::load(path));
+    expectRestored(mahalanobisFunction, *MahalanobisFunction::load(path, -1, exemcl::DiagonalMahalanobis(weights)));
+    EXPECT_THROW(MahalanobisFunction::load(path, -1, exemcl::DiagonalMahalanobis(2.0 * weights)), std::runtime_error);
+
+    // Weights and dimensionality reductions are restored alongside the ground set.
+    Function weightedFunction(exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V), -1);
+    weightedFunction.save(path);
+    expectRestored(weightedFunction, *Function::load(path));
+    for (auto reduction : {exemcl::cpu::DimensionReduction<TypeParam>::pca(V, 3, true), exemcl::cpu::DimensionReduction<TypeParam>::pca(V, 5),
+                           exemcl::cpu::DimensionReduction<TypeParam>::randomProjection(V.cols(), 8, 42)}) {
+        Function reducedFunction(V, reduction, -1);
+        reducedFunction.save(path);
+        auto restoredReducedFunction = Function::load(path);
+        expectRestored(reducedFunction, *restoredReducedFunction);
+        for (auto& S : testData.subsets)
+            EXPECT_EQ(reducedFunction.bounds(S), restoredReducedFunction->bounds(S));
+    }
+
+    // Concurrent writers of the same artifact use distinct temporary files, hence the artifact is complete and no temporary file is left behind.
+    std::vector<std::thread> writers;
+    for (unsigned int t = 0; t < 4; t++)
+        writers.emplace_back([&]() { plainFunction.save(path); });
+    for (auto& writer : writers)
+        writer.join();
+    expectRestored(plainFunction, *Function::load(path));
+    for (auto& entry : std::filesystem::directory_iterator(std::filesystem::path(path).parent_path()))
+        EXPECT_NE(entry.path().string().rfind(path + ".", 0), 0ul);
+
+    // Artifacts of other scalar types, truncated artifacts and other files are rejected.
+    using OtherDataType = typename std::conditional<std::is_same<TypeParam, float>::value, double, float>::type;
+    EXPECT_THROW(exemcl::cpu::ExemplarClusteringSubmodularFunction<OtherDataType>::load(path), std::runtime_error);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(Function::load(path), std::runtime_error);
+    writeBinaryGroundSet(path, V, true);
+    EXPECT_THROW(Function::load(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(CPUTests, MixedPrecisionGreedy) {
+    // Load test data.
+    SubmodularTestData testData = loadSubmodularTestData("exem");
+    exemcl::MatrixX<double> candidates = testData.groundSet.topRows(100);
+
+    // Create the fast and the exact function.
+    exemcl::cpu::HalfPrecisionExemplarClusteringSubmodularFunction<Eigen::half> fastFunction(testData.groundSet.cast<float>(), -1);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<double> exactFunction(testData.groundSet, -1);
+
+    // A greedy optimization solely using the exact function serves as reference.
+    auto reference = exemcl::MixedPrecisionGreedy(exactFunction, exactFunction, 0.0, 0.0).optimize(candidates, 8);
+    auto result = exemcl::MixedPrecisionGreedy(fastFunction, exactFunction).optimize(candidates, 8);
+
+    // The selection needs to match the exact one, whereas fewer exact gains are computed than in a single step of the reference.
+    EXPECT_EQ(reference.indices, result.indices);
+    EXPECT_NEAR(reference.value, result.value, FP64_ERROR_TOLERANCY);
+    EXPECT_LT(result.reranked, candidates.rows());
+}
+
+TYPED_TEST(CPUTests, ExemplarClusteringMemoryLimit) {
+    // A ground set, which does not fit, is streamed in tiles of whole reduction blocks, and batches are evaluated by fewer workers.
+    const unsigned long n = 3000, d = 16;
+    std::srand(42);
+    exemcl::MatrixX<TypeParam> V = exemcl::MatrixX<TypeParam>::Random(n, d);
+    std::vector<exemcl::MatrixX<double>> S_multi;
+    for (unsigned int i = 0; i < 12; i++)
+        S_multi.push_back(V.topRows(i + 1).template cast<double>());
+    const exemcl::MatrixX<double>& S = S_multi.back();
+    exemcl::VectorX<double> elem = V.row(n - 1).template cast<double>();
+    std::vector<exemcl::VectorXRef<double>> elems;
+    for (auto& S_i : S_multi)
+        elems.emplace_back(S_i.row(0));
+
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> function(V, 4);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> reference(V, 4);
+    EXPECT_EQ(std::get<2>(function.calculateProblemDependentChunking(S_multi.size(), d, S.rows())), n);
+    function.setMemoryLimit(8 * 1024);
+    EXPECT_EQ(function.getMemoryLimit(), 8 * 1024);
+    auto chunking = function.calculateProblemDependentChunking(S_multi.size(), d, S.rows());
+    EXPECT_GT(std::get<0>(chunking), 8ul * 1024);
+    EXPECT_LT(std::get<1>(chunking), 4ul);
+    EXPECT_LT(std::get<2>(chunking), n);
+    EXPECT_EQ(std::get<2>(chunking) % exemcl::ReductionBlockSize, 0ul);
+
+    // In compensated (or deterministic) mode, tiles do not change any result.
+    for (bool deterministic : {false, true}) {
+        for (auto* f : {&function, &reference}) {
+            f->setReductionMode(deterministic ? exemcl::ReductionMode::Naive : exemcl::ReductionMode::Compensated);
+            f->setDeterministic(deterministic);
+        }
+        EXPECT_EQ(function(S), reference(S));
+        EXPECT_EQ(function(S, elem), reference(S, elem));
+        EXPECT_EQ(function(S_multi), reference(S_multi));
+        EXPECT_EQ(function(S_multi, elem), reference(S_multi, elem));
+        EXPECT_EQ(function(S, elems), reference(S, elems));
+    }
+
+    // Weighted ground sets are tiled alike.
+    auto weighted = exemcl::cpu::WeightedGroundSet<TypeParam>::collapseDuplicates(V);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> weightedFunction(weighted, 4);
+    exemcl::cpu::ExemplarClusteringSubmodularFunction<TypeParam> weightedReference(weighted, 4);
+    weightedFunction.setMemoryLimit(8 * 1024);
+    EXPECT_EQ(weightedFunction(S_multi), weightedReference(S_multi));
+
+    // Limits, which do not suffice for a single evaluation, are rejected, whereas -1 removes the limit.
+    EXPECT_THROW(function.setMemoryLimit(64), std::runtime_error);
+    EXPECT_EQ(function.getMemoryLimit(), 8 * 1024);
+    function.setMemoryLimit(4 * 1024);
+    exemcl::MatrixX<double> largeS = V.topRows(200).template cast<double>();
+    EXPECT_THROW(function(largeS), std::runtime_error);
+    function.setMemoryLimit(-1);
+    EXPECT_EQ(function(largeS), reference(largeS));
+
+    // Changing the limit releases the arenas, which have been sized for the previous limit.
+    EXPECT_EQ(function.getIdleArenaCount(), 1ul);
+    function.setMemoryLimit(8 * 1024);
+    EXPECT_EQ(function.getIdleArenaCount(), 0ul);
+    EXPECT_EQ(function(S_multi), reference(S_multi));
+    EXPECT_EQ(function(S, elems), reference(S, elems));
+}
+
 int main(int argc, char** argv) {
     std::cout << "Reading testfiles from: " << TESTFILES_ROOT << std::endl;
     ::testing::InitGoogleTest(&argc, argv);
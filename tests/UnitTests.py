@@ -1,6 +1,7 @@
 import itertools
 import multiprocessing
 import os
+import pickle
 import random
 import shutil
 import unittest
@@ -31,6 +32,11 @@ def F_gain(V, S, e):
     return F(V, np.append(S, [e], axis=0)) - F(V, S)
 
 
+def F_shared(ground_set, S):
+    # The ground set has been unpickled, i.e. attached to by name, within the worker.
+    return exemcl.ExemplarClustering.from_ground_set(ground_set, worker_count=1)(S)
+
+
 class TestCase(unittest.TestCase):
     @classmethod
     def setUpClass(cls) -> None:
@@ -69,9 +75,15 @@ class TestCase(unittest.TestCase):
         pool.join()
 
         # Compare to output.
-        for precision, device in itertools.product(["fp16", "fp32", "fp64"], ["cpu", "gpu"]):
-            # Skip FP16/CPU combination.
-            if precision == "fp16" and device == "cpu":
+        for precision, device in itertools.product(["fp16", "bf16", "fp32", "fp64", "int8"], ["cpu", "gpu"]):
+            # Skip BF16/GPU and INT8/GPU combinations.
+            if precision in ["bf16", "int8"] and device == "gpu":
+                continue
+
+            # BF16 and INT8 precision are approximate, hence only the function values are compared.
+            if precision in ["bf16", "int8"]:
+                exem = exemcl.ExemplarClustering(ground_set=V, precision=precision, device=device, worker_count=-1)
+                self.assertTrue(np.allclose(np.asarray(f_values), np.asarray(exem(S)), rtol=self.rtol))
                 continue
 
             # Make comparison.
@@ -89,6 +101,31 @@ class TestCase(unittest.TestCase):
         pandas.DataFrame(f_values).to_csv(os.path.join(out_dir, "testfiles", "exem", "f_values.csv"), index_label="ObjectID")
         pandas.DataFrame(marginal_values).to_csv(os.path.join(out_dir, "testfiles", "exem", "marginal_values.csv"), index_label="ObjectID")
 
+    def test_SharedGroundSet(self):
+        # Generate ground set and subsets.
+        V, _ = make_blobs(n_samples=N, centers=3, n_features=DIM, random_state=0)
+        S = [V[np.random.choice(range(N), random.randint(1, 20))] for _ in range(16)]
+
+        for dissimilarity, weights in [("sqeuclidean", None), ("mahalanobis", np.linspace(0.5, 2.0, DIM))]:
+            ground_set = exemcl.GroundSet(V, precision="fp64", dissimilarity=dissimilarity, weights=weights)
+            f_values = exemcl.ExemplarClustering.from_ground_set(ground_set, worker_count=1)(S)
+
+            # Only ground sets in shared memory are pickled (by name).
+            with self.assertRaises(RuntimeError):
+                pickle.dumps(ground_set)
+            shared = ground_set.to_shared_memory()
+            self.assertEqual(pickle.loads(pickle.dumps(shared)).shared_memory_name, shared.shared_memory_name)
+
+            # Workers attach on unpickling. The publishing handle is kept alive until all tasks are done, since its release removes the name.
+            with multiprocessing.Pool(2) as pool:
+                f_values_shared = pool.starmap(F_shared, [(shared, s) for s in S])
+            self.assertTrue(np.allclose(np.asarray(f_values), np.asarray(f_values_shared), atol=self.atol, rtol=self.rtol))
+
+            # Attaching by name yields the published dissimilarity.
+            attached = exemcl.GroundSet.attach(shared.shared_memory_name, weights=weights)
+            self.assertEqual(attached.dissimilarity, dissimilarity)
+            del attached, shared
+
 
 if __name__ == '__main__':
     unittest.main()